@@ -9,21 +9,27 @@
 
 // #include "absl/flags/flag.h"
 // #include "absl/flags/parse.h"
-#include "flags/flags_table_int.h"
-#include "table/table.h"
+#include "1/similarity.h"
+#include "flags/flags_columnar_int.h"
+#include "table/columnar_table.h"
 
-int process(Table<int> table)
+int process(ColumnarTable<int> table)
 {
-    // Read the table into two vectors
-    std::vector<int> column1;
-    std::vector<int> column2;
-
-    for (Row<int> row : table)
+    if (table.columnCount() < 2)
     {
-        column1.push_back(row[0]);
-        column2.push_back(row[1]);
+        if (table.size() == 0)
+        {
+            std::cout << "Sum of counts: 0" << std::endl;
+            return 0;
+        }
+        std::cerr << "Expected two columns, found " << table.columnCount() << std::endl;
+        return 1;
     }
 
+    // The parser already stored each column contiguously
+    Row<int> column1 = table.column(0);
+    Row<int> column2 = table.column(1);
+
     // print the contents of the vectors
     std::cout << "Column 1: ";
     for (const auto &val : column1)
@@ -38,14 +44,9 @@ int process(Table<int> table)
     }
     std::cout << std::endl;
 
-    // print the contents of the vectors
-    int sum = std::transform_reduce(
-        column1.begin(), column1.end(), 0, std::plus<>(),
-        [&column2](int val)
-        {
-            int count = std::count(column2.begin(), column2.end(), val);
-            return val * count;
-        });
+    // Sort both columns and merge them instead of counting column2 once per
+    // element of column1
+    long long sum = similarityScore(table.releaseColumn(0), table.releaseColumn(1));
 
     std::cout << "Sum of counts: " << sum << std::endl;
 
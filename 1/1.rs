@@ -22,12 +22,13 @@ fn process(table: &Table<i32>) {
         }
     }
 
-    let sum: i32 = column1.iter()
+    // Accumulated in 64 bits, like the C++ version; large inputs overflow i32
+    let sum: i64 = column1.iter()
         .map(|val| {
             let sim = column2.iter()
                 .map(|v| if *v == *val { 1 } else { 0 })
-                .sum::<i32>();
-            *val * sim
+                .sum::<i64>();
+            *val as i64 * sim
         })
         .sum();
     
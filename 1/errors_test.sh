@@ -0,0 +1,36 @@
+#!/bin/bash
+# Runs day 1 on malformed inputs: each must exit nonzero with a message, and
+# a failed parse must still show up in the --trace_json output.
+#
+# Usage: errors_test.sh DAY_1
+set -euo pipefail
+
+binary=$1
+work=${TEST_TMPDIR:-$(mktemp -d)}
+failures=0
+
+# expect_failure NAME CONTENTS PATTERN: the run must fail and print PATTERN
+expect_failure() {
+    local input=$work/$1.txt trace=$work/$1.json status=0 output
+    printf '%b' "$2" > "$input"
+    output=$("$binary" --filename="$input" --trace_json="$trace" 2>&1) || status=$?
+    if [ "$status" -eq 0 ] || ! grep -q "$3" <<< "$output"; then
+        echo "FAILED: $1 exited $status" >&2
+        echo "$output" >&2
+        failures=$((failures + 1))
+    fi
+}
+
+expect_failure ragged '1   2\n3\n' 'Failed to parse input'
+if ! grep -q '"name":"parse"' "$work/ragged.json"; then
+    echo "FAILED: the failed parse is missing from the trace" >&2
+    failures=$((failures + 1))
+fi
+expect_failure one_column '1\n2\n' 'Expected two columns'
+
+# An empty file still has an answer
+output=$("$binary" --filename=/dev/null 2>&1)
+grep -q '^Sum of counts: 0$' <<< "$output" || { echo "FAILED: empty input" >&2; failures=$((failures + 1)); }
+
+[ "$failures" -eq 0 ] && echo "PASSED"
+exit "$failures"
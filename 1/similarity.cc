@@ -0,0 +1,44 @@
+#include "1/similarity.h"
+
+#include <algorithm>
+#include <cstddef>
+
+long long similarityScore(std::vector<int> left, std::vector<int> right)
+{
+    std::sort(left.begin(), left.end());
+    std::sort(right.begin(), right.end());
+
+    long long sum = 0;
+    size_t l = 0;
+    size_t r = 0;
+    while (l < left.size() && r < right.size())
+    {
+        if (left[l] < right[r])
+        {
+            l++;
+        }
+        else if (right[r] < left[l])
+        {
+            r++;
+        }
+        else
+        {
+            // Equal runs on both sides contribute value * leftRun * rightRun
+            const int value = left[l];
+            size_t leftRun = 0;
+            while (l < left.size() && left[l] == value)
+            {
+                leftRun++;
+                l++;
+            }
+            size_t rightRun = 0;
+            while (r < right.size() && right[r] == value)
+            {
+                rightRun++;
+                r++;
+            }
+            sum += static_cast<long long>(value) * static_cast<long long>(leftRun * rightRun);
+        }
+    }
+    return sum;
+}
@@ -0,0 +1,12 @@
+#ifndef SIMILARITY_H_
+#define SIMILARITY_H_
+
+#include <vector>
+
+// Sum over left of value * (number of times value occurs in right).
+// Both lists are sorted and then walked once in step, so this is
+// O(n log n) rather than one scan of right per element of left. The sum is
+// accumulated in 64 bits.
+long long similarityScore(std::vector<int> left, std::vector<int> right);
+
+#endif  // SIMILARITY_H_
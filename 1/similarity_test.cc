@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "1/similarity.h"
+
+TEST(Similarity, Example) {
+    EXPECT_EQ(similarityScore({3, 4, 2, 1, 3, 3}, {4, 3, 5, 3, 9, 3}), 31);
+}
+
+TEST(Similarity, EmptyAndDisjoint) {
+    EXPECT_EQ(similarityScore({}, {1, 2}), 0);
+    EXPECT_EQ(similarityScore({1, 2}, {3, 4}), 0);
+}
+
+TEST(Similarity, DoesNotOverflowInt) {
+    std::vector<int> left(50000, 99999);
+    std::vector<int> right(50000, 99999);
+    EXPECT_EQ(similarityScore(left, right), 99999LL * 50000 * 50000);
+}
+
+TEST(Similarity, MatchesQuadraticCount) {
+    std::mt19937 rng(1);
+    std::vector<int> left(2000), right(2000);
+    for (size_t i = 0; i < left.size(); i++) {
+        left[i] = rng() % 300 - 100;
+        right[i] = rng() % 300 - 100;
+    }
+    long long expected = 0;
+    for (int value : left) {
+        expected += static_cast<long long>(value) * std::count(right.begin(), right.end(), value);
+    }
+    EXPECT_EQ(similarityScore(left, right), expected);
+}
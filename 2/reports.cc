@@ -0,0 +1,166 @@
+#include "2/reports.h"
+
+#include <algorithm>
+
+#include "table/cpu_features.h"
+
+#if TABLE_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t kNoSkip = static_cast<size_t>(-1);
+
+// Position of the first level whose step to the next kept level falls
+// outside [low, high], ignoring the level at skip. Returns size when the
+// steps are all in range.
+size_t firstViolation(const int* levels, size_t size, int low, int high, size_t skip) {
+    size_t previous = skip == 0 ? 1 : 0;
+    for (size_t i = previous + 1; i < size; i++) {
+        if (i == skip) {
+            continue;
+        }
+        const int diff = levels[i] - levels[previous];
+        if (diff < low || diff > high) {
+            return previous;
+        }
+        previous = i;
+    }
+    return size;
+}
+
+// Safe in one direction with at most one removal. If the first bad step is
+// between levels i and j, any removal that fixes the row has to take out i
+// or j, since every other removal leaves that step in place.
+bool isSafeWithDampener(const int* levels, size_t size, int low, int high) {
+    size_t bad = firstViolation(levels, size, low, high, kNoSkip);
+    if (bad == size) {
+        return true;
+    }
+    if (firstViolation(levels, size, low, high, bad) == size) {
+        return true;
+    }
+    return bad + 1 < size && firstViolation(levels, size, low, high, bad + 1) == size;
+}
+
+// Whether bits [from, to) of words are all set
+bool allBitsSet(const uint64_t* words, size_t from, size_t to) {
+    while (from < to) {
+        size_t bit = from % 64;
+        size_t count = std::min<size_t>(64 - bit, to - from);
+        uint64_t mask = (count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1)) << bit;
+        if ((words[from / 64] & mask) != mask) {
+            return false;
+        }
+        from += count;
+    }
+    return true;
+}
+
+#if TABLE_HAVE_X86_SIMD
+__attribute__((target("avx2")))
+void classifyStepsAvx2(const int* values, size_t steps, uint64_t* up, uint64_t* down) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i four = _mm256_set1_epi32(4);
+    const __m256i minusFour = _mm256_set1_epi32(-4);
+    size_t k = 0;
+    for (; k + 64 <= steps; k += 64) {
+        uint64_t upWord = 0;
+        uint64_t downWord = 0;
+        for (size_t lane = 0; lane < 64; lane += 8) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + k + lane));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + k + lane + 1));
+            __m256i d = _mm256_sub_epi32(b, a);
+            __m256i isUp = _mm256_and_si256(_mm256_cmpgt_epi32(d, zero), _mm256_cmpgt_epi32(four, d));
+            __m256i isDown = _mm256_and_si256(_mm256_cmpgt_epi32(zero, d), _mm256_cmpgt_epi32(d, minusFour));
+            upWord |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(isUp))) << lane;
+            downWord |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(isDown))) << lane;
+        }
+        up[k / 64] = upWord;
+        down[k / 64] = downWord;
+    }
+    if (k < steps) {
+        classifyStepsScalar(values + k, steps - k, up + k / 64, down + k / 64);
+    }
+}
+#endif
+
+}  // namespace
+
+void classifyStepsScalar(const int* values, size_t steps, uint64_t* up, uint64_t* down) {
+    for (size_t w = 0; w * 64 < steps; w++) {
+        uint64_t upWord = 0;
+        uint64_t downWord = 0;
+        size_t count = std::min<size_t>(64, steps - w * 64);
+        for (size_t bit = 0; bit < count; bit++) {
+            size_t k = w * 64 + bit;
+            const int diff = values[k + 1] - values[k];
+            upWord |= uint64_t(diff >= 1 && diff <= 3) << bit;
+            downWord |= uint64_t(diff >= -3 && diff <= -1) << bit;
+        }
+        up[w] = upWord;
+        down[w] = downWord;
+    }
+}
+
+void classifySteps(const int* values, size_t steps, uint64_t* up, uint64_t* down) {
+#if TABLE_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        classifyStepsAvx2(values, steps, up, down);
+        return;
+    }
+#endif
+    classifyStepsScalar(values, steps, up, down);
+}
+
+void markMonotonicRows(const Table<int>& table, size_t begin, size_t end, std::vector<uint8_t>& safe) {
+    safe.assign(end - begin, 0);
+    if (begin >= end) {
+        return;
+    }
+    const int* base = table[begin].data();
+    size_t count = table[end - 1].end() - base;
+    if (count < 2) {
+        return;
+    }
+    size_t steps = count - 1;
+    std::vector<uint64_t> up((steps + 63) / 64);
+    std::vector<uint64_t> down((steps + 63) / 64);
+    classifySteps(base, steps, up.data(), down.data());
+
+    for (size_t r = begin; r < end; r++) {
+        Row<int> row = table[r];
+        if (row.size() < 2) {
+            continue;
+        }
+        size_t first = row.data() - base;
+        size_t last = first + row.size() - 1;
+        safe[r - begin] = allBitsSet(up.data(), first, last) || allBitsSet(down.data(), first, last);
+    }
+}
+
+bool isRowSafe(const Row<int>& row) {
+    if (row.size() < 3) {
+        // Removing one level leaves at most one step to check
+        return !row.empty();
+    }
+    return isSafeWithDampener(row.data(), row.size(), 1, 3) ||
+           isSafeWithDampener(row.data(), row.size(), -3, -1);
+}
+
+int countSafeRows(const Table<int>& rows, size_t begin, size_t end) {
+    end = std::min(end, rows.size());
+    // Most rows are settled by the vectorized check; only the ones it
+    // rejects need the dampener
+    std::vector<uint8_t> monotonic;
+    markMonotonicRows(rows, begin, end, monotonic);
+
+    int safeCount = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (monotonic[i - begin] || isRowSafe(rows[i])) {
+            safeCount++;
+        }
+    }
+    return safeCount;
+}
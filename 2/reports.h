@@ -0,0 +1,140 @@
+#ifndef REPORTS_H_
+#define REPORTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "table/table.h"
+
+enum class Direction {
+    UP,
+    DOWN, 
+    UNKNOWN
+};
+
+// Returns an iterator that skips the element at the given index
+template<typename Iterator>
+class SkipIterator {
+private:
+    Iterator current;
+    Iterator end;
+    size_t skipIndex;
+    size_t currentIndex;
+
+public:
+    SkipIterator(Iterator begin, Iterator end, size_t skipIndex) 
+        : current(begin), end(end), skipIndex(skipIndex), currentIndex(0) {
+        // Advance to first non-skipped element
+        if (currentIndex == skipIndex && current != end) {
+            ++current;
+            ++currentIndex;
+        }
+    }
+
+    SkipIterator& operator++() {
+        ++current;
+        ++currentIndex;
+        if (currentIndex == skipIndex && current != end) {
+            ++current;
+            ++currentIndex;
+        }
+        return *this;
+    }
+
+    SkipIterator operator++(int) {
+        SkipIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    auto operator*() const -> decltype(*current) {
+        return *current;
+    }
+
+    bool operator!=(const SkipIterator& other) const {
+        return current != other.current;
+    }
+
+    bool operator==(const SkipIterator& other) const {
+        return current == other.current;
+    }
+};
+
+// Helper function to create a skip iterator range
+template<typename Iterator>
+std::pair<SkipIterator<Iterator>, SkipIterator<Iterator>> 
+makeSkipRange(Iterator begin, Iterator end, size_t skipIndex) {
+    return {
+        SkipIterator<Iterator>(begin, end, skipIndex),
+        SkipIterator<Iterator>(end, end, skipIndex)
+    };
+}
+
+template<typename Iterator>
+bool checkRow(Iterator begin, Iterator end) {
+    Direction direction = Direction::UNKNOWN;
+    Iterator colItr = begin;
+    int lastValue = *colItr;
+    colItr++;
+    while (true) {
+        const int diff = *colItr - lastValue;
+        if (direction == Direction::UNKNOWN) {
+            if (diff == 1 || diff == 2 || diff == 3) {
+                direction = Direction::UP; // Initial direction
+            } else if (diff == -1 || diff == -2 || diff == -3) {
+                direction = Direction::DOWN; // Initial direction
+            } else {
+                break; // Skip rows that are not safe
+            }
+        } else if (direction == Direction::UP) {
+            if (diff <= 0 || diff > 3) {
+                break; // Skip rows that are not safe
+            }
+        } else if (direction == Direction::DOWN) {
+            if (diff >= 0 || diff < -3) {
+                break; // Skip rows that are not safe
+            }
+        }
+        lastValue = *colItr;
+        if (++colItr == end) {
+            // If we reach the end of the row, it is a safe row
+            return true;
+            break;
+        }
+    }
+    return false; 
+}
+
+// Reference version of isRowSafe: re-checks the row once per removable
+// level, which is O(n^2) per row
+inline bool isRowSafeBruteForce(const Row<int>& row) {
+    for (size_t i = 0; i < row.size(); i++) {
+        auto [begin, end] = makeSkipRange(row.begin(), row.end(), i);
+        if (checkRow(begin, end)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether the row is safe once at most one level is removed, in O(n)
+bool isRowSafe(const Row<int>& row);
+
+// Classifies the steps values[k + 1] - values[k] for k in [0, steps): bit k
+// of up is set when the step is in [1, 3] and bit k of down when it is in
+// [-3, -1]. up and down need (steps + 63) / 64 words. Reads steps + 1 values.
+void classifySteps(const int* values, size_t steps, uint64_t* up, uint64_t* down);
+void classifyStepsScalar(const int* values, size_t steps, uint64_t* up, uint64_t* down);
+
+// Batch check for rows [begin, end) of a table: safe[r - begin] is set when
+// row r is safe without removing anything. The rows are classified in one
+// pass over their contiguous storage, steps across row boundaries included
+// and then ignored. Rows with fewer than two levels are left unset.
+void markMonotonicRows(const Table<int>& table, size_t begin, size_t end, std::vector<uint8_t>& safe);
+
+// Number of safe rows in [begin, end) of a table, dampener included
+int countSafeRows(const Table<int>& rows, size_t begin, size_t end);
+
+#endif  // REPORTS_H_
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "2/reports.h"
+
+static bool safe(std::vector<int> levels) {
+    return isRowSafe(Row<int>(levels));
+}
+
+TEST(Reports, Examples) {
+    EXPECT_TRUE(safe({7, 6, 4, 2, 1}));
+    EXPECT_FALSE(safe({1, 2, 7, 8, 9}));
+    EXPECT_FALSE(safe({9, 7, 6, 2, 1}));
+    EXPECT_TRUE(safe({1, 3, 2, 4, 5}));
+    EXPECT_TRUE(safe({8, 6, 4, 4, 1}));
+    EXPECT_TRUE(safe({1, 3, 6, 7, 9}));
+}
+
+TEST(Reports, RemovingFirstOrLastLevel) {
+    EXPECT_TRUE(safe({9, 1, 2, 3}));
+    EXPECT_TRUE(safe({1, 2, 3, 9}));
+    EXPECT_TRUE(safe({5, 1, 2, 3}));
+    EXPECT_FALSE(safe({9, 1, 2, 9}));
+}
+
+TEST(Reports, ShortRows) {
+    EXPECT_FALSE(safe({}));
+    EXPECT_TRUE(safe({4}));
+    EXPECT_TRUE(safe({4, 4}));
+}
+
+// Property test: the linear check agrees with the brute-force one on random
+// rows. Small level ranges make rows that are one removal away from safe
+// common.
+TEST(Reports, MatchesBruteForce) {
+    std::mt19937 rng(2024);
+    for (int iteration = 0; iteration < 200000; iteration++) {
+        std::vector<int> levels(3 + rng() % 8);
+        int level = rng() % 20;
+        for (int& l : levels) {
+            l = level;
+            level += static_cast<int>(rng() % 9) - 4;
+        }
+        Row<int> row(levels);
+        if (isRowSafe(row) != isRowSafeBruteForce(row)) {
+            std::ostringstream description;
+            for (int l : levels) {
+                description << l << " ";
+            }
+            FAIL() << "Mismatch for row: " << description.str();
+        }
+    }
+}
+
+TEST(Reports, ClassifyStepsMatchesScalar) {
+    std::mt19937 rng(7);
+    std::vector<int> values(1000);
+    for (int& v : values) {
+        v = static_cast<int>(rng() % 12);
+    }
+    for (size_t steps : {0, 1, 7, 8, 63, 64, 65, 200, 999}) {
+        std::vector<uint64_t> up(16), down(16), upScalar(16), downScalar(16);
+        classifySteps(values.data(), steps, up.data(), down.data());
+        classifyStepsScalar(values.data(), steps, upScalar.data(), downScalar.data());
+        EXPECT_EQ(up, upScalar) << steps;
+        EXPECT_EQ(down, downScalar) << steps;
+    }
+}
+
+TEST(Reports, MarkMonotonicRowsMatchesCheckRow) {
+    std::mt19937 rng(11);
+    std::vector<std::vector<int>> rows;
+    for (int r = 0; r < 5000; r++) {
+        std::vector<int> levels(rng() % 10);
+        int level = rng() % 50;
+        int direction = rng() % 2 ? 1 : -1;
+        for (int& l : levels) {
+            l = level;
+            level += direction * static_cast<int>(rng() % 4) + (rng() % 20 == 0 ? 5 : 0);
+        }
+        rows.push_back(levels);
+    }
+    Table<int> table(rows);
+
+    std::vector<uint8_t> safe;
+    markMonotonicRows(table, 100, 4100, safe);
+    ASSERT_EQ(safe.size(), 4000);
+    for (size_t r = 100; r < 4100; r++) {
+        bool expected = table[r].size() >= 2 && checkRow(table[r].begin(), table[r].end());
+        EXPECT_EQ(safe[r - 100] != 0, expected) << "row " << r;
+    }
+}
@@ -1,46 +1,52 @@
-#include "flags/flags_string.h"
+#include "flags/flags_stream.h"
+#include "3/instructions.h"
+#include "exec/pool.h"
+#include <algorithm>
 #include <iostream>
-#include <regex>
-#include <vector>
+#include <optional>
 
-int process(const std::string& content) {
+// Folds one window into streamed, the summary of everything before it
+static size_t processWindow(ThreadPool& pool, InstructionSummary& streamed, std::string_view buffer, bool last) {
 
-    // Vector to store pairs of numbers from mul() instances
-    std::vector<std::pair<int, int>> mul_pairs;
-    
-    // Regex pattern to match mul(num1,num2), do(), or don't()
-    std::regex pattern(R"(mul\((\d{1,3}),(\d{1,3})\)|do\(\)|don't\(\))");
-    
-    // Iterator for searching through the content
-    std::sregex_iterator start(content.begin(), content.end(), pattern);
-    std::sregex_iterator end;
-    
-    bool mul_enabled = true;  // Track if mul operations are enabled
-    
-    // Extract all matches
-    for (std::sregex_iterator i = start; i != end; ++i) {
-        std::smatch match = *i;
-        std::string full_match = match[0].str();  // The entire matched text
-        
-        if (full_match == "do()") {
-            mul_enabled = true;
-        } else if (full_match == "don't()") {
-            mul_enabled = false;
-        } else if (full_match.substr(0, 3) == "mul" && mul_enabled) {
-            // This is a mul() match and multiplication is enabled
-            int num1 = std::stoi(match[1].str());  // First captured group
-            int num2 = std::stoi(match[2].str());  // Second captured group
-            mul_pairs.push_back({num1, num2});
-        }
-    }
-    
-    int sum = 0;
-    for (const auto& pair : mul_pairs) {
-        sum += pair.first * pair.second;  // Calculate the sum of products
+    // An instruction starting in the last few bytes may continue in the next
+    // window, so those bytes are carried over unless this is the end
+    size_t limit = buffer.size();
+    if (!last) {
+        limit = buffer.size() < kMaxInstructionLength ? 0 : buffer.size() - (kMaxInstructionLength - 1);
     }
 
+    // Each chunk is summarized for both possible mul_enabled states on entry,
+    // so chunks can be scanned concurrently; folding the summaries in order
+    // recovers the sequential result
+    constexpr size_t kMinChunkSize = 1 << 18;
+    size_t chunkSize = std::max(kMinChunkSize, limit / (size_t(pool.size()) * 8));
+    InstructionSummary summary = pool.parallel_reduce(
+        0, limit, chunkSize, InstructionSummary(),
+        [buffer](size_t begin, size_t end) { return summarizeChunk(buffer, begin, end); },
+        [](const InstructionSummary& a, const InstructionSummary& b) { return combine(a, b); });
+    streamed = combine(streamed, summary);
+
+    return limit;
+}
+
+int main(int argc, char *argv[]) {
+
+    // Built with the first window: run_stream parses --threads first
+    std::optional<ThreadPool> pool;
+    // Everything streamed so far. Memory starts with mul enabled.
+    InstructionSummary streamed;
 
-    std::cout << "Sum of products: " << sum << std::endl;
-    
-    return 0;
-}
\ No newline at end of file
+    return run_stream(
+        argc, argv,
+        [&](std::string_view buffer, bool last) {
+            if (!pool) {
+                pool.emplace(thread_count());
+                std::cerr << "Threads: " << pool->size() << std::endl;
+            }
+            return processWindow(*pool, streamed, buffer, last);
+        },
+        [&] {
+            std::cout << "Sum of products: " << streamed.sum(true) << std::endl;
+            return 0;
+        });
+}
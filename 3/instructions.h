@@ -0,0 +1,188 @@
+#ifndef INSTRUCTIONS_H_
+#define INSTRUCTIONS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// One match of mul\((\d{1,3}),(\d{1,3})\)|do\(\)|don't\(\)
+struct Instruction
+{
+  enum Kind { MUL, DO, DONT };
+
+  Kind kind;
+  int left = 0;
+  int right = 0;
+};
+
+namespace instructions_internal {
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Reads 1-3 digits starting at i. Returns the position after them, or i if
+// there is no digit there.
+inline size_t readNumber(const char* text, size_t size, size_t i, int& value) {
+    size_t start = i;
+    value = 0;
+    while (i < size && i - start < 3 && isDigit(text[i])) {
+        value = value * 10 + (text[i] - '0');
+        i++;
+    }
+    return i;
+}
+
+// Position of the next 'm' or 'd' at or after i, or size. Every instruction
+// starts with one of the two, so everything else is skipped 16 bytes at a
+// time.
+inline size_t nextCandidate(const char* text, size_t size, size_t i) {
+#if defined(__SSE2__)
+    const __m128i m = _mm_set1_epi8('m');
+    const __m128i d = _mm_set1_epi8('d');
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, m), _mm_cmpeq_epi8(bytes, d)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (i < size && text[i] != 'm' && text[i] != 'd') {
+        i++;
+    }
+    return i;
+}
+
+}  // namespace instructions_internal
+
+// Single pass scanner over corrupted memory. It finds the same
+// leftmost-first, non-overlapping matches as the regex above, without
+// backtracking or allocation. A failed match resumes at the byte where it
+// failed, since none of the instructions can start inside the prefix that
+// did match. Calls visit(const Instruction&) for every instruction found.
+//
+// Only instructions starting before startLimit are reported; the text after
+// it is read just to complete them. Instructions never start inside one
+// another, so scanning [0, a) and [a, b) this way finds exactly what one
+// scan of [0, b) does.
+template <typename Visit>
+void scanInstructions(std::string_view input, size_t startLimit, Visit&& visit) {
+    using instructions_internal::nextCandidate;
+    using instructions_internal::readNumber;
+    const char* text = input.data();
+    const size_t size = input.size();
+
+    size_t i = 0;
+    while ((i = nextCandidate(text, startLimit, i)) < startLimit) {
+        const char c = text[i];
+        if (c == 'm') {
+            if (i + 4 > size || text[i + 1] != 'u' || text[i + 2] != 'l' || text[i + 3] != '(') {
+                i++;
+                continue;
+            }
+            Instruction instruction{Instruction::MUL};
+            size_t j = readNumber(text, size, i + 4, instruction.left);
+            if (j == i + 4 || j >= size || text[j] != ',') {
+                i = j;
+                continue;
+            }
+            size_t k = readNumber(text, size, j + 1, instruction.right);
+            if (k == j + 1 || k >= size || text[k] != ')') {
+                i = k;
+                continue;
+            }
+            visit(instruction);
+            i = k + 1;
+        } else if (c == 'd') {
+            if (i + 4 <= size && text[i + 1] == 'o' && text[i + 2] == '(' && text[i + 3] == ')') {
+                visit(Instruction{Instruction::DO});
+                i += 4;
+            } else if (i + 7 <= size && input.compare(i + 1, 6, "on't()") == 0) {
+                visit(Instruction{Instruction::DONT});
+                i += 7;
+            } else {
+                i++;
+            }
+        }
+    }
+}
+
+template <typename Visit>
+void scanInstructions(std::string_view input, Visit&& visit) {
+    scanInstructions(input, input.size(), visit);
+}
+
+// Length of mul(123,456), the longest instruction
+constexpr size_t kMaxInstructionLength = 12;
+
+// What a stretch of memory contributes, for both possible do()/don't()
+// states on entry, plus the state it leaves behind. Summaries of adjacent
+// stretches combine associatively, so a large input can be summarized in
+// chunks concurrently and folded in order.
+struct InstructionSummary
+{
+  enum Exit { UNCHANGED, ENABLED, DISABLED };
+
+  long long enabledSum = 0;   // sum of products if mul() is enabled on entry
+  long long disabledSum = 0;  // sum of products if mul() is disabled on entry
+  Exit exit = UNCHANGED;
+
+  bool enabledAfter(bool enabledOnEntry) const {
+    return exit == UNCHANGED ? enabledOnEntry : exit == ENABLED;
+  }
+
+  long long sum(bool enabledOnEntry) const {
+    return enabledOnEntry ? enabledSum : disabledSum;
+  }
+};
+
+// Summary of first followed by second
+inline InstructionSummary combine(const InstructionSummary& first, const InstructionSummary& second) {
+    InstructionSummary result;
+    result.enabledSum = first.enabledSum + second.sum(first.enabledAfter(true));
+    result.disabledSum = first.disabledSum + second.sum(first.enabledAfter(false));
+    result.exit = second.exit == InstructionSummary::UNCHANGED ? first.exit : second.exit;
+    return result;
+}
+
+// Summarizes the instructions starting before startLimit (see
+// scanInstructions)
+inline InstructionSummary summarizeInstructions(std::string_view input, size_t startLimit) {
+    InstructionSummary summary;
+    bool enabledFromEnabled = true;
+    bool enabledFromDisabled = false;
+    scanInstructions(input, startLimit, [&](const Instruction& instruction) {
+        switch (instruction.kind) {
+            case Instruction::DO:
+                enabledFromEnabled = enabledFromDisabled = true;
+                summary.exit = InstructionSummary::ENABLED;
+                break;
+            case Instruction::DONT:
+                enabledFromEnabled = enabledFromDisabled = false;
+                summary.exit = InstructionSummary::DISABLED;
+                break;
+            case Instruction::MUL: {
+                long long product = static_cast<long long>(instruction.left) * instruction.right;
+                summary.enabledSum += enabledFromEnabled ? product : 0;
+                summary.disabledSum += enabledFromDisabled ? product : 0;
+                break;
+            }
+        }
+    });
+    return summary;
+}
+
+// Summary of the instructions starting in [begin, end) of input. The
+// chunk's text runs past end far enough to finish an instruction that
+// straddles the boundary.
+inline InstructionSummary summarizeChunk(std::string_view input, size_t begin, size_t end) {
+    size_t textEnd = std::min(input.size(), end + kMaxInstructionLength - 1);
+    return summarizeInstructions(input.substr(begin, textEnd - begin), end - begin);
+}
+
+#endif  // INSTRUCTIONS_H_
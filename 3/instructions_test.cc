@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+#include "3/instructions.h"
+
+// Renders instructions back to text so scanner and regex output compare
+static std::vector<std::string> scan(std::string_view text) {
+    std::vector<std::string> found;
+    scanInstructions(text, [&](const Instruction& instruction) {
+        switch (instruction.kind) {
+            case Instruction::DO:
+                found.push_back("do()");
+                break;
+            case Instruction::DONT:
+                found.push_back("don't()");
+                break;
+            case Instruction::MUL:
+                found.push_back("mul(" + std::to_string(instruction.left) + "," +
+                                std::to_string(instruction.right) + ")");
+                break;
+        }
+    });
+    return found;
+}
+
+static std::vector<std::string> scanWithRegex(const std::string& text) {
+    static const std::regex pattern(R"(mul\((\d{1,3}),(\d{1,3})\)|do\(\)|don't\(\))");
+    std::vector<std::string> found;
+    for (std::sregex_iterator i(text.begin(), text.end(), pattern), end; i != end; ++i) {
+        const std::smatch& match = *i;
+        if (match[1].matched) {
+            found.push_back("mul(" + std::to_string(std::stoi(match[1].str())) + "," +
+                            std::to_string(std::stoi(match[2].str())) + ")");
+        } else {
+            found.push_back(match[0].str());
+        }
+    }
+    return found;
+}
+
+TEST(Instructions, Example) {
+    std::string text = "xmul(2,4)&mul[3,7]!^don't()_mul(5,5)+mul(32,64](mul(11,8)undo()?mul(8,5))";
+    EXPECT_EQ(scan(text), (std::vector<std::string>{
+        "mul(2,4)", "don't()", "mul(5,5)", "mul(11,8)", "do()", "mul(8,5)"}));
+}
+
+TEST(Instructions, RejectsMalformed) {
+    EXPECT_TRUE(scan("mul(1234,5) mul(1,2 mul( 1,2) mul(1,) mul(,1) do( don't").empty());
+    EXPECT_EQ(scan("mulmul(1,2)dodo()ddon't()"),
+              (std::vector<std::string>{"mul(1,2)", "do()", "don't()"}));
+    EXPECT_EQ(scan("mul(12,mul(3,4)"), (std::vector<std::string>{"mul(3,4)"}));
+}
+
+// The scanner must agree with the regex it replaces on random corrupted
+// memory built from instruction fragments
+TEST(Instructions, MatchesRegex) {
+    const std::vector<std::string> fragments = {
+        "mul(", "mul", "(", ")", ",", "1", "23", "456", "7890", "do()", "don't()",
+        "do", "don't", "n't", "d", "m", "u", "l", "x", " ", "mul(1,2)", "\n"};
+    std::mt19937 rng(3);
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        std::string text;
+        for (int f = 0; f < 60; f++) {
+            text += fragments[rng() % fragments.size()];
+        }
+        ASSERT_EQ(scan(text), scanWithRegex(text)) << text;
+    }
+}
+
+// Summing sequentially has to match folding summaries of arbitrary chunks,
+// including chunks that cut instructions in half
+TEST(Instructions, ChunkSummariesFoldToSequentialSum) {
+    const std::vector<std::string> fragments = {
+        "mul(", "12", ",", "345", ")", "do()", "don't()", "mul(7,8)", "xx", "d", "m"};
+    std::mt19937 rng(5);
+    for (int iteration = 0; iteration < 500; iteration++) {
+        std::string text;
+        for (int f = 0; f < 200; f++) {
+            text += fragments[rng() % fragments.size()];
+        }
+
+        bool enabled = true;
+        long long expected = 0;
+        scanInstructions(text, [&](const Instruction& instruction) {
+            if (instruction.kind == Instruction::MUL && enabled) {
+                expected += static_cast<long long>(instruction.left) * instruction.right;
+            }
+            if (instruction.kind != Instruction::MUL) {
+                enabled = instruction.kind == Instruction::DO;
+            }
+        });
+
+        InstructionSummary folded;
+        size_t begin = 0;
+        while (begin < text.size()) {
+            size_t end = std::min(text.size(), begin + 1 + rng() % 40);
+            folded = combine(folded, summarizeChunk(text, begin, end));
+            begin = end;
+        }
+        ASSERT_EQ(folded.sum(true), expected) << text;
+    }
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Checks that --threads reaches day 3's pool, which is only built once the
+# streaming main has parsed the flags.
+#
+# Usage: threads_test.sh DAY_3
+set -euo pipefail
+
+binary=$1
+for threads in 1 3; do
+    output=$("$binary" --filename=test_data.txt --threads=$threads 2>&1)
+    if ! grep -qx "Threads: $threads" <<< "$output"; then
+        echo "FAILED: --threads=$threads did not reach the pool" >&2
+        echo "$output" >&2
+        exit 1
+    fi
+done
+echo "PASSED"
@@ -4,10 +4,13 @@
 #include <fstream>
 #include <vector>
 
+#include "4/xmas.h"
+#include "exec/pool.h"
 #include "flags/flags_table_char.h"
+#include "table/grid_scan.h"
 #include "table/table.h"
 
-int process(Table<char> table)
+int process(const Table<char>& table)
 {
     std::cout << "Table contents:" << std::endl;
     std::cout << "===============" << std::endl;
@@ -34,39 +37,12 @@ int process(Table<char> table)
 
 
     // Count the number of X-shaped MAS patterns (two MAS sequences crossing at A)
-    int xmas_count = 0;
-    
-    // Check each position as a potential center 'A' of an X-shaped MAS pattern
-    // We need at least 1 cell margin on all sides for the full X pattern
-    for (int row = 1; row < static_cast<int>(table.size()) - 1; ++row) {
-        for (int col = 1; col < static_cast<int>(table[row].size()) - 1; ++col) {
-            // The center must be 'A'
-            if (table[row][col] != 'A') {
-                continue;
-            }
-            
-            // Check both diagonals for MAS or SAM patterns
-            // Diagonal 1: top-left to bottom-right
-            char tl = table[row - 1][col - 1];  // top-left
-            char br = table[row + 1][col + 1];  // bottom-right
-            
-            // Diagonal 2: top-right to bottom-left  
-            char tr = table[row - 1][col + 1];  // top-right
-            char bl = table[row + 1][col - 1];  // bottom-left
-            
-            // Check if diagonal 1 forms MAS or SAM
-            bool diag1_valid = (tl == 'M' && br == 'S') || (tl == 'S' && br == 'M');
-            
-            // Check if diagonal 2 forms MAS or SAM
-            bool diag2_valid = (tr == 'M' && bl == 'S') || (tr == 'S' && bl == 'M');
-            
-            // If both diagonals form valid MAS/SAM patterns, we found an X-MAS
-            if (diag1_valid && diag2_valid) {
-                xmas_count++;
-            }
-        }
-    }
-    
+    // on a sentinel-padded grid, so the kernel needs no bounds checks, one
+    // cache-sized band of rows per task
+    Grid<char> grid = xmasGrid(table);
+    ThreadPool pool(thread_count());
+    long long xmas_count = scanGridBands(pool, grid, countXmas);
+
     std::cout << "Number of X-shaped MAS patterns found: " << xmas_count << std::endl;
 
     return 0;
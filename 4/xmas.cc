@@ -0,0 +1,105 @@
+#include "4/xmas.h"
+
+#include "table/cpu_features.h"
+
+#if TABLE_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+bool isDiagonal(char a, char b) {
+    return (a == 'M' && b == 'S') || (a == 'S' && b == 'M');
+}
+
+#if TABLE_HAVE_X86_SIMD
+inline __m128i loadSse2(const char* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+// Lanes where one end of the diagonal is 'M' and the other 'S'
+inline __m128i diagonalSse2(__m128i a, __m128i b) {
+    const __m128i m = _mm_set1_epi8('M');
+    const __m128i s = _mm_set1_epi8('S');
+    __m128i ms = _mm_and_si128(_mm_cmpeq_epi8(a, m), _mm_cmpeq_epi8(b, s));
+    __m128i sm = _mm_and_si128(_mm_cmpeq_epi8(a, s), _mm_cmpeq_epi8(b, m));
+    return _mm_or_si128(ms, sm);
+}
+
+long long countXmasSse2(const Grid<char>& grid, size_t rowBegin, size_t rowEnd) {
+    const __m128i a = _mm_set1_epi8('A');
+    long long count = 0;
+    for (size_t r = rowBegin; r < rowEnd; r++) {
+        const char* center = grid.rowData(r);
+        const char* up = center - grid.stride();
+        const char* down = center + grid.stride();
+        for (size_t c = 0; c < grid.width(); c += 16) {
+            __m128i hits = _mm_cmpeq_epi8(loadSse2(center + c), a);
+            hits = _mm_and_si128(hits, diagonalSse2(loadSse2(up + c - 1), loadSse2(down + c + 1)));
+            hits = _mm_and_si128(hits, diagonalSse2(loadSse2(up + c + 1), loadSse2(down + c - 1)));
+            count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(hits)));
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx2")))
+inline __m256i loadAvx2(const char* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2")))
+inline __m256i diagonalAvx2(__m256i a, __m256i b) {
+    const __m256i m = _mm256_set1_epi8('M');
+    const __m256i s = _mm256_set1_epi8('S');
+    __m256i ms = _mm256_and_si256(_mm256_cmpeq_epi8(a, m), _mm256_cmpeq_epi8(b, s));
+    __m256i sm = _mm256_and_si256(_mm256_cmpeq_epi8(a, s), _mm256_cmpeq_epi8(b, m));
+    return _mm256_or_si256(ms, sm);
+}
+
+__attribute__((target("avx2")))
+long long countXmasAvx2(const Grid<char>& grid, size_t rowBegin, size_t rowEnd) {
+    const __m256i a = _mm256_set1_epi8('A');
+    long long count = 0;
+    for (size_t r = rowBegin; r < rowEnd; r++) {
+        const char* center = grid.rowData(r);
+        const char* up = center - grid.stride();
+        const char* down = center + grid.stride();
+        for (size_t c = 0; c < grid.width(); c += 32) {
+            __m256i hits = _mm256_cmpeq_epi8(loadAvx2(center + c), a);
+            hits = _mm256_and_si256(hits, diagonalAvx2(loadAvx2(up + c - 1), loadAvx2(down + c + 1)));
+            hits = _mm256_and_si256(hits, diagonalAvx2(loadAvx2(up + c + 1), loadAvx2(down + c - 1)));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(hits)));
+        }
+    }
+    return count;
+}
+#endif
+
+}  // namespace
+
+long long countXmasScalar(const Grid<char>& grid, size_t rowBegin, size_t rowEnd) {
+    const ptrdiff_t upLeft = grid.offset<-1, -1>();
+    const ptrdiff_t upRight = grid.offset<-1, 1>();
+    long long count = 0;
+    for (size_t r = rowBegin; r < rowEnd; r++) {
+        const char* cell = grid.rowData(r);
+        for (size_t c = 0; c < grid.width(); c++, cell++) {
+            if (*cell == 'A' && isDiagonal(cell[upLeft], cell[-upLeft]) && isDiagonal(cell[upRight], cell[-upRight])) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+long long countXmas(const Grid<char>& grid, size_t rowBegin, size_t rowEnd) {
+#if TABLE_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        return countXmasAvx2(grid, rowBegin, rowEnd);
+    }
+    return countXmasSse2(grid, rowBegin, rowEnd);
+#else
+    return countXmasScalar(grid, rowBegin, rowEnd);
+#endif
+}
@@ -0,0 +1,31 @@
+#ifndef XMAS_H_
+#define XMAS_H_
+
+#include <cstddef>
+
+#include "table/grid.h"
+#include "table/table.h"
+
+// Sentinel around the grid; it matches none of 'M', 'A' and 'S'
+constexpr char kXmasPadding = '.';
+
+// Sentinel columns needed right of the halo, so a 32-byte load at any
+// column plus its diagonal neighbours stays inside the grid
+constexpr size_t kXmasSlack = 32;
+
+// Grid laid out the way countXmas expects
+inline Grid<char> xmasGrid(const Table<char>& table) {
+    return Grid<char>(table, kXmasPadding, 1, kXmasSlack);
+}
+
+// Counts the cells in rows [rowBegin, rowEnd) that are the centre 'A' of an
+// X-MAS: both diagonals through the cell read MAS or SAM. The grid needs a
+// halo of at least 1 and kXmasSlack columns of slack, all holding a
+// sentinel. Uses AVX2 or SSE2 to test 32 or 16 centres per step, chosen at
+// runtime.
+long long countXmas(const Grid<char>& grid, size_t rowBegin, size_t rowEnd);
+
+// One cell at a time, for reference
+long long countXmasScalar(const Grid<char>& grid, size_t rowBegin, size_t rowEnd);
+
+#endif  // XMAS_H_
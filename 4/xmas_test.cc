@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "4/xmas.h"
+
+static Table<char> grid(const std::vector<std::string>& lines) {
+    std::string text;
+    for (const std::string& line : lines) {
+        text += line + "\n";
+    }
+    return Table<char>(std::string_view(text));
+}
+
+// The loop day 4 used before the padded kernel
+static long long naive(const Table<char>& table) {
+    long long count = 0;
+    auto diagonal = [](char a, char b) { return (a == 'M' && b == 'S') || (a == 'S' && b == 'M'); };
+    for (int row = 1; row < static_cast<int>(table.size()) - 1; ++row) {
+        for (int col = 1; col < static_cast<int>(table[row].size()) - 1; ++col) {
+            if (table[row][col] == 'A' &&
+                diagonal(table[row - 1][col - 1], table[row + 1][col + 1]) &&
+                diagonal(table[row - 1][col + 1], table[row + 1][col - 1])) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static long long count(const Table<char>& table) {
+    Grid<char> cells = xmasGrid(table);
+    return countXmas(cells, 0, cells.height());
+}
+
+TEST(Xmas, Example) {
+    Table<char> table = grid({
+        "MMMSXXMASM",
+        "MSAMXMSMSA",
+        "AMXSXMAAMM",
+        "MSAMASMSMX",
+        "XMASAMXAMM",
+        "XXAMMXXAMA",
+        "SMSMSASXSS",
+        "SAXAMASAAA",
+        "MAMMMXMMMM",
+        "MXMXAXMASX",
+    });
+    EXPECT_EQ(count(table), 9);
+}
+
+TEST(Xmas, EdgesDoNotCount) {
+    // An 'A' on the border has no full X, and the sentinel must not match
+    EXPECT_EQ(count(grid({"A"})), 0);
+    EXPECT_EQ(count(grid({"MAS", "SAM"})), 0);
+    EXPECT_EQ(count(grid({"M.S", ".A.", "M.S"})), 1);
+    EXPECT_EQ(count(grid({"S.S", ".A.", "M.M"})), 1);
+    EXPECT_EQ(count(grid({"M.M", ".A.", "M.M"})), 0);
+}
+
+TEST(Xmas, RaggedRowsArePadded) {
+    // Short rows are filled out with the sentinel, which never matches
+    EXPECT_EQ(count(grid({"M.S", ".A", "M.S"})), 1);
+    EXPECT_EQ(count(grid({"M.S", ".A", "M"})), 0);
+}
+
+TEST(Xmas, MatchesNaiveOnRandomGrids) {
+    std::mt19937 rng(4);
+    const char letters[] = "XMAS";
+    for (int trial = 0; trial < 50; trial++) {
+        size_t rows = 1 + rng() % 40;
+        size_t cols = 1 + rng() % 100;
+        std::vector<std::string> lines(rows, std::string(cols, 'X'));
+        for (std::string& line : lines) {
+            for (char& c : line) {
+                c = letters[rng() % 4];
+            }
+        }
+        Table<char> table = grid(lines);
+        Grid<char> cells = xmasGrid(table);
+        long long expected = naive(table);
+        EXPECT_EQ(countXmas(cells, 0, rows), expected);
+        EXPECT_EQ(countXmasScalar(cells, 0, rows), expected);
+    }
+}
+
+TEST(Xmas, RowRangesAddUp) {
+    std::mt19937 rng(7);
+    const char letters[] = "XMAS";
+    std::vector<std::string> lines(64, std::string(70, 'X'));
+    for (std::string& line : lines) {
+        for (char& c : line) {
+            c = letters[rng() % 4];
+        }
+    }
+    Grid<char> cells = xmasGrid(grid(lines));
+    long long whole = countXmas(cells, 0, 64);
+    long long split = countXmas(cells, 0, 20) + countXmas(cells, 20, 64);
+    EXPECT_EQ(whole, split);
+}
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+#include "5/precedence.h"
+#include "exec/pool.h"
+#include "flags/flags_string.h"
+#include "table/sections.h"
+#include "table/table.h"
+
+int process(std::string_view content) {
+    // "a|b" rules, a blank line, then comma separated updates
+    auto [rules, updates] = parseSections(content, Section<int>{'|'}, Section<int>{','});
+
+    PrecedenceMatrix precedence(rules);
+    std::cout << "Rules: " << precedence.ruleCount() << " (" << (precedence.dense() ? "dense" : "sparse")
+              << " matrix)" << std::endl;
+    std::cout << "Updates: " << updates.size() << std::endl;
+
+    // Updates are independent, so they are checked in parallel chunks; only
+    // the middle page of a reordered update is ever worked out
+    ThreadPool pool(thread_count());
+    constexpr size_t kUpdatesPerChunk = 1024;
+    UpdateTotals totals;
+    try {
+        totals = pool.parallel_reduce(
+            0, updates.size(), kUpdatesPerChunk, UpdateTotals(),
+            [&](size_t begin, size_t end) { return checkUpdates(updates, precedence, begin, end); },
+            [](UpdateTotals a, const UpdateTotals& b) { return a += b; });
+    } catch (const std::invalid_argument& e) {
+        // The pool passes on the first chunk's error, e.g. cyclic rules
+        std::cerr << "Unable to check updates: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Invalid updates: " << totals.invalid << std::endl;
+    std::cout << "Total sum of center elements: " << totals.invalidCenters << std::endl;
+    std::cout << "Total sum of reordered center elements: " << totals.reorderedCenters << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "5/precedence.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+PrecedenceMatrix::PrecedenceMatrix(const Table<int>& table) {
+    int largest = -1;
+    for (size_t r = 0; r < table.size(); r++) {
+        Row<int> rule = table[r];
+        if (rule.size() != 2 || rule[0] < 0 || rule[1] < 0) {
+            throw std::invalid_argument("PrecedenceMatrix: rule " + std::to_string(r) +
+                                        " is not two page IDs");
+        }
+        largest = std::max({largest, rule[0], rule[1]});
+    }
+
+    useSparse = largest >= kDenseLimit;
+    if (!useSparse) {
+        dimension = largest + 1;
+        bits.assign((static_cast<size_t>(dimension) * dimension + 63) / 64, 0);
+    }
+    for (const Row<int>& rule : table) {
+        if (useSparse) {
+            sparse.insert(pack(rule[0], rule[1]));
+        } else {
+            size_t bit = static_cast<size_t>(rule[0]) * dimension + rule[1];
+            bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+    }
+    rules = table.size();
+}
+
+bool isOrdered(const Row<int>& update, const PrecedenceMatrix& precedence) {
+    if (update.size() < 2) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < update.size(); i++) {
+        if (!precedence.before(update[i], update[i + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int reorderedMiddle(const Row<int>& update, const PrecedenceMatrix& precedence, std::vector<int>& scratch) {
+    const size_t n = update.size();
+    if (n == 0) {
+        throw std::invalid_argument("reorderedMiddle: empty update");
+    }
+    const size_t middle = n / 2;
+
+    // scratch[i] = pages that must come before page i, then n flags for the
+    // ranks seen so far
+    scratch.assign(2 * n, 0);
+    int* rank = scratch.data();
+    int* seen = scratch.data() + n;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            bool forward = precedence.before(update[i], update[j]);
+            bool backward = precedence.before(update[j], update[i]);
+            if (forward && backward) {
+                throw std::invalid_argument("reorderedMiddle: the rules form a cycle");
+            }
+            if (forward) {
+                rank[j]++;
+            } else if (backward) {
+                rank[i]++;
+            }
+        }
+    }
+    bool total = true;
+    for (size_t i = 0; i < n && total; i++) {
+        total = static_cast<size_t>(rank[i]) < n && !seen[rank[i]];
+        if (total) {
+            seen[rank[i]] = 1;
+        }
+    }
+    if (total) {
+        for (size_t i = 0; i < n; i++) {
+            if (static_cast<size_t>(rank[i]) == middle) {
+                return update[i];
+            }
+        }
+    }
+
+    // Partial order: place pages whose predecessors are all placed, earliest
+    // in the update first, until the middle position is filled. seen marks
+    // the placed pages.
+    std::fill(seen, seen + n, 0);
+    for (size_t placed = 0;; placed++) {
+        size_t next = n;
+        for (size_t i = 0; i < n; i++) {
+            if (!seen[i] && rank[i] == 0) {
+                next = i;
+                break;
+            }
+        }
+        if (next == n) {
+            throw std::invalid_argument("reorderedMiddle: the rules form a cycle");
+        }
+        if (placed == middle) {
+            return update[next];
+        }
+        seen[next] = 1;
+        for (size_t j = 0; j < n; j++) {
+            if (!seen[j] && precedence.before(update[next], update[j])) {
+                rank[j]--;
+            }
+        }
+    }
+}
+
+UpdateTotals checkUpdates(const Table<int>& updates, const PrecedenceMatrix& precedence, size_t begin, size_t end) {
+    UpdateTotals totals;
+    std::vector<int> scratch;
+    for (size_t i = begin; i < end; i++) {
+        Row<int> update = updates[i];
+        if (isOrdered(update, precedence)) {
+            continue;
+        }
+        totals.invalid++;
+        if (!update.empty()) {
+            totals.invalidCenters += update[update.size() / 2];
+            totals.reorderedCenters += reorderedMiddle(update, precedence, scratch);
+        }
+    }
+    return totals;
+}
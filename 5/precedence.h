@@ -0,0 +1,85 @@
+#ifndef PRECEDENCE_H_
+#define PRECEDENCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "table/table.h"
+
+// The "a|b" page-ordering rules as a relation with O(1) lookup. When every
+// page ID is below kDenseLimit the relation is a dense bit matrix (1250
+// bytes for the usual two-digit IDs); larger IDs fall back to a hash set of
+// packed pairs.
+class PrecedenceMatrix {
+public:
+    static constexpr int kDenseLimit = 1024;
+
+    PrecedenceMatrix() = default;
+
+    // One rule per row, each row holding the page that must come first and
+    // the page that must come after it. Throws std::invalid_argument for a
+    // row that is not two non-negative IDs.
+    explicit PrecedenceMatrix(const Table<int>& rules);
+
+    // Whether a rule says page a comes before page b
+    bool before(int a, int b) const {
+        if (dense()) {
+            if (a < 0 || b < 0 || a >= dimension || b >= dimension) {
+                return false;
+            }
+            size_t bit = static_cast<size_t>(a) * dimension + b;
+            return (bits[bit >> 6] >> (bit & 63)) & 1;
+        }
+        return sparse.count(pack(a, b)) > 0;
+    }
+
+    bool dense() const { return !useSparse; }
+    size_t ruleCount() const { return rules; }
+
+private:
+    static uint64_t pack(int a, int b) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+    }
+
+    int dimension = 0;
+    bool useSparse = false;
+    size_t rules = 0;
+    std::vector<uint64_t> bits;
+    std::unordered_set<uint64_t> sparse;
+};
+
+// Whether every adjacent pair of pages in the update is covered by a rule.
+// As in the original day 5 solution, updates with fewer than two pages are
+// not in order.
+bool isOrdered(const Row<int>& update, const PrecedenceMatrix& precedence);
+
+// Middle page of the update once it is put in an order that respects the
+// rules, found without building the reordered update. Each page's rank is
+// the number of pages in the update that must precede it; when the rules
+// order every pair (the puzzle's case) the ranks are 0 to n - 1 and the
+// middle page is the one ranked n / 2. Otherwise Kahn's algorithm runs on
+// the rules between the update's pages and stops once it places the middle
+// page. scratch is reused between calls. Throws std::invalid_argument for an
+// empty update or rules that form a cycle among its pages.
+int reorderedMiddle(const Row<int>& update, const PrecedenceMatrix& precedence, std::vector<int>& scratch);
+
+// Per-chunk tallies for a run over the updates
+struct UpdateTotals {
+    size_t invalid = 0;
+    long long invalidCenters = 0;    // middle pages of the out-of-order updates, as given
+    long long reorderedCenters = 0;  // middle pages of the same updates once reordered
+
+    UpdateTotals& operator+=(const UpdateTotals& other) {
+        invalid += other.invalid;
+        invalidCenters += other.invalidCenters;
+        reorderedCenters += other.reorderedCenters;
+        return *this;
+    }
+};
+
+// Checks updates [begin, end) and reorders the ones that break the rules
+UpdateTotals checkUpdates(const Table<int>& updates, const PrecedenceMatrix& precedence, size_t begin, size_t end);
+
+#endif  // PRECEDENCE_H_
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "5/precedence.h"
+
+static Table<int> rules(std::string_view text) {
+    return Table<int>(text, '|');
+}
+
+static bool ordered(std::vector<int> update, const PrecedenceMatrix& precedence) {
+    return isOrdered(Row<int>(update), precedence);
+}
+
+TEST(Precedence, DenseLookup) {
+    PrecedenceMatrix precedence(rules("47|53\n97|13\n97|61\n"));
+    EXPECT_TRUE(precedence.dense());
+    EXPECT_EQ(precedence.ruleCount(), 3u);
+    EXPECT_TRUE(precedence.before(47, 53));
+    EXPECT_FALSE(precedence.before(53, 47));
+    EXPECT_TRUE(precedence.before(97, 61));
+    EXPECT_FALSE(precedence.before(13, 61));
+    // IDs outside the matrix have no rules
+    EXPECT_FALSE(precedence.before(98, 13));
+    EXPECT_FALSE(precedence.before(5000, 13));
+}
+
+TEST(Precedence, SparseForLargeIds) {
+    PrecedenceMatrix precedence(rules("100000|7\n7|2000000\n"));
+    EXPECT_FALSE(precedence.dense());
+    EXPECT_TRUE(precedence.before(100000, 7));
+    EXPECT_TRUE(precedence.before(7, 2000000));
+    EXPECT_FALSE(precedence.before(7, 100000));
+}
+
+TEST(Precedence, RejectsMalformedRules) {
+    EXPECT_THROW(PrecedenceMatrix(rules("1|2|3\n")), std::invalid_argument);
+    EXPECT_THROW(PrecedenceMatrix(rules("-1|2\n")), std::invalid_argument);
+    EXPECT_TRUE(PrecedenceMatrix(rules("")).dense());
+}
+
+TEST(Precedence, UpdateOrder) {
+    PrecedenceMatrix precedence(rules("75|47\n47|61\n61|53\n75|61\n"));
+    EXPECT_TRUE(ordered({75, 47, 61, 53}, precedence));
+    EXPECT_FALSE(ordered({47, 75, 61}, precedence));
+    // Only adjacent pairs are checked, and an unknown pair is out of order
+    EXPECT_FALSE(ordered({75, 53}, precedence));
+    EXPECT_FALSE(ordered({75}, precedence));
+    EXPECT_FALSE(ordered({}, precedence));
+}
+
+TEST(Precedence, ReorderedMiddleOfExample) {
+    PrecedenceMatrix precedence(rules(
+        "47|53\n97|13\n97|61\n97|47\n75|29\n61|13\n75|53\n29|13\n97|29\n53|29\n61|53\n"
+        "97|53\n61|29\n47|13\n75|47\n97|75\n47|61\n75|61\n47|29\n75|13\n53|13\n"));
+    Table<int> updates(std::string_view("75,97,47,61,53\n61,13,29\n97,13,75,29,47\n75,47,61,53,29\n"), ',');
+    std::vector<int> scratch;
+    EXPECT_EQ(reorderedMiddle(updates[0], precedence, scratch), 47);
+    EXPECT_EQ(reorderedMiddle(updates[1], precedence, scratch), 29);
+    EXPECT_EQ(reorderedMiddle(updates[2], precedence, scratch), 47);
+
+    UpdateTotals totals = checkUpdates(updates, precedence, 0, updates.size());
+    EXPECT_EQ(totals.invalid, 3u);
+    EXPECT_EQ(totals.invalidCenters, 47 + 13 + 75);
+    EXPECT_EQ(totals.reorderedCenters, 123);
+}
+
+TEST(Precedence, ReorderedMiddleMatchesSort) {
+    std::mt19937 rng(5);
+    std::vector<int> order(60);
+    for (int i = 0; i < 60; i++) {
+        order[i] = 10 + i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    std::string text;
+    for (size_t i = 0; i < order.size(); i++) {
+        for (size_t j = i + 1; j < order.size(); j++) {
+            text += std::to_string(order[i]) + "|" + std::to_string(order[j]) + "\n";
+        }
+    }
+    PrecedenceMatrix precedence(rules(text));
+
+    std::vector<int> scratch;
+    for (int trial = 0; trial < 200; trial++) {
+        std::vector<int> update(order.begin(), order.begin() + 1 + rng() % 25);
+        std::shuffle(update.begin(), update.end(), rng);
+        std::vector<int> sorted = update;
+        std::sort(sorted.begin(), sorted.end(), [&](int a, int b) { return precedence.before(a, b); });
+        EXPECT_EQ(reorderedMiddle(Row<int>(update), precedence, scratch), sorted[sorted.size() / 2]);
+    }
+}
+
+TEST(Precedence, ReorderedMiddleOfPartialOrder) {
+    // 1 before 2 and 3, 3 before 4; 2 is free of 3 and 4
+    PrecedenceMatrix precedence(rules("1|2\n1|3\n3|4\n"));
+    std::vector<int> scratch;
+    std::vector<int> update = {4, 2, 3, 1, 5};
+    // Kahn order, taking the earliest ready page in the update: 1, 2, 3, 4, 5
+    EXPECT_EQ(reorderedMiddle(Row<int>(update), precedence, scratch), 3);
+
+    std::vector<int> cyclic = {1, 2, 3};
+    PrecedenceMatrix cycle(rules("1|2\n2|3\n3|1\n"));
+    EXPECT_THROW(reorderedMiddle(Row<int>(cyclic), cycle, scratch), std::invalid_argument);
+    std::vector<int> empty;
+    EXPECT_THROW(reorderedMiddle(Row<int>(empty), precedence, scratch), std::invalid_argument);
+}
+
+TEST(Precedence, ContradictoryPairIsACycle) {
+    // Each order of the pair breaks one rule, whichever way the update lists it
+    PrecedenceMatrix twoCycle(rules("1|2\n2|1\n"));
+    std::vector<int> scratch;
+    std::vector<int> forward = {1, 2, 3};
+    std::vector<int> backward = {2, 1, 3};
+    EXPECT_THROW(reorderedMiddle(Row<int>(forward), twoCycle, scratch), std::invalid_argument);
+    EXPECT_THROW(reorderedMiddle(Row<int>(backward), twoCycle, scratch), std::invalid_argument);
+    Table<int> updates(std::string_view("1,2,3\n"), ',');
+    EXPECT_THROW(checkUpdates(updates, twoCycle, 0, updates.size()), std::invalid_argument);
+}
@@ -0,0 +1,286 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "1/similarity.h"
+#include "2/reports.h"
+#include "3/instructions.h"
+#include "4/xmas.h"
+#include "exec/pool.h"
+#include "gen/generators.h"
+#include "table/columnar_table.h"
+#include "table/grid_scan.h"
+#include "table/table.h"
+
+// Throughput benchmarks for the table parser and each day's core work, over
+// synthetic inputs from 1 KiB to 1 GiB. Run with e.g.
+//   bazel run -c opt //bench -- --benchmark_filter=ParseTable
+// Puzzle-shaped inputs come from //gen. Inputs are generated on first use
+// and the latest one is kept, so the large sizes are only built once per
+// benchmark.
+
+namespace {
+
+enum class Format { INT_LINE, CHAR_LINE, TWO_COLUMNS, REPORTS, MEMORY, GRID };
+
+// Small fixed-seed generator for the single-line inputs, so runs are
+// comparable
+class Lcg
+{
+public:
+  uint32_t next()
+  {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  }
+  uint32_t below(uint32_t n) { return next() % n; }
+
+private:
+  uint64_t state = 2024;
+};
+
+std::string generate(Format format, size_t bytes)
+{
+  Lcg rng;
+  std::string out;
+  out.reserve(bytes + 64);
+  switch (format) {
+    case Format::INT_LINE:
+      while (out.size() < bytes) {
+        out += std::to_string(rng.below(100000));
+        out += ' ';
+      }
+      break;
+    case Format::CHAR_LINE:
+      while (out.size() < bytes) {
+        out += "XMAS"[rng.below(4)];
+      }
+      break;
+    case Format::TWO_COLUMNS:
+      return generateInput(InputFormat::TWO_COLUMNS, bytes);
+    case Format::REPORTS:
+      return generateInput(InputFormat::REPORTS, bytes);
+    case Format::MEMORY:
+      return generateInput(InputFormat::MEMORY, bytes);
+    case Format::GRID:
+      return generateInput(InputFormat::GRID, bytes);
+  }
+  return out;
+}
+
+const std::string& input(Format format, size_t bytes)
+{
+  static Format cachedFormat;
+  static size_t cachedBytes = 0;
+  static std::string cached;
+  if (cachedBytes != bytes || cachedFormat != format) {
+    cached.clear();
+    cached.shrink_to_fit();
+    cached = generate(format, bytes);
+    cachedFormat = format;
+    cachedBytes = bytes;
+  }
+  return cached;
+}
+
+void sizes(benchmark::internal::Benchmark* b)
+{
+  b->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
+}
+
+void BM_ParseRowInt(benchmark::State& state)
+{
+  const std::string& line = input(Format::INT_LINE, state.range(0));
+  size_t items = 0;
+  for (auto _ : state) {
+    std::vector<int> row = parseRow<int>(line);
+    items = row.size();
+    benchmark::DoNotOptimize(row.data());
+  }
+  state.SetBytesProcessed(state.iterations() * line.size());
+  state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_ParseRowInt)->Apply(sizes);
+
+void BM_ParseRowChar(benchmark::State& state)
+{
+  const std::string& line = input(Format::CHAR_LINE, state.range(0));
+  for (auto _ : state) {
+    std::vector<char> row = parseRow<char>(line);
+    benchmark::DoNotOptimize(row.data());
+  }
+  state.SetBytesProcessed(state.iterations() * line.size());
+  state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_ParseRowChar)->Apply(sizes);
+
+void BM_ParseTableStream(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    std::istringstream stream(text);
+    std::vector<std::vector<int>> table = parseTable<int>(stream, ' ');
+    rows = table.size();
+    benchmark::DoNotOptimize(table.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_ParseTableStream)->Apply(sizes);
+
+void BM_ParseTableView(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    std::vector<std::vector<int>> table = parseTable<int>(std::string_view(text), ' ');
+    rows = table.size();
+    benchmark::DoNotOptimize(table.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_ParseTableView)->Apply(sizes);
+
+void BM_TableFromStream(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    std::istringstream stream(text);
+    Table<int> table(stream);
+    rows = table.size();
+    benchmark::DoNotOptimize(table);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TableFromStream)->Apply(sizes);
+
+void BM_TableFromView(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    Table<int> table{std::string_view(text)};
+    rows = table.size();
+    benchmark::DoNotOptimize(table);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TableFromView)->Apply(sizes);
+
+void BM_TableFromRows(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  std::vector<std::vector<int>> rows = parseTable<int>(std::string_view(text), ' ');
+  for (auto _ : state) {
+    Table<int> table(rows);
+    benchmark::DoNotOptimize(table);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows.size());
+}
+BENCHMARK(BM_TableFromRows)->Apply(sizes);
+
+void BM_ParseTableParallel(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    Table<int> table = parseTableParallel<int>(text, 0);
+    rows = table.size();
+    benchmark::DoNotOptimize(table);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_ParseTableParallel)->Apply(sizes)->UseRealTime();
+
+void BM_ColumnarTable(benchmark::State& state)
+{
+  const std::string& text = input(Format::TWO_COLUMNS, state.range(0));
+  size_t rows = 0;
+  for (auto _ : state) {
+    ColumnarTable<int> table{std::string_view(text)};
+    rows = table.size();
+    benchmark::DoNotOptimize(table.column(0).data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_ColumnarTable)->Apply(sizes);
+
+// Day 1: similarity score of the two columns, copies included
+void BM_Day1Similarity(benchmark::State& state)
+{
+  const std::string& text = input(Format::TWO_COLUMNS, state.range(0));
+  ColumnarTable<int> table{std::string_view(text)};
+  std::vector<int> left = table.releaseColumn(0);
+  std::vector<int> right = table.releaseColumn(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(similarityScore(left, right));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * left.size());
+}
+BENCHMARK(BM_Day1Similarity)->Apply(sizes);
+
+// Day 2: safe reports over an already parsed table
+void BM_Day2SafeRows(benchmark::State& state)
+{
+  const std::string& text = input(Format::REPORTS, state.range(0));
+  Table<int> table{std::string_view(text)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(countSafeRows(table, 0, table.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * table.size());
+}
+BENCHMARK(BM_Day2SafeRows)->Apply(sizes);
+
+// Day 3: one pass over the corrupted memory
+void BM_Day3Summarize(benchmark::State& state)
+{
+  const std::string& text = input(Format::MEMORY, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(summarizeInstructions(text, text.size()).sum(true));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Day3Summarize)->Apply(sizes);
+
+// Day 4: X-MAS count on one thread and across the shared pool
+void BM_Day4CountXmas(benchmark::State& state)
+{
+  const std::string& text = input(Format::GRID, state.range(0));
+  Grid<char> grid = xmasGrid(Table<char>(std::string_view(text)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(countXmas(grid, 0, grid.height()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * grid.height() * grid.width());
+}
+BENCHMARK(BM_Day4CountXmas)->Apply(sizes);
+
+void BM_Day4CountXmasBands(benchmark::State& state)
+{
+  const std::string& text = input(Format::GRID, state.range(0));
+  Grid<char> grid = xmasGrid(Table<char>(std::string_view(text)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scanGridBands(ThreadPool::shared(), grid, countXmas));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.SetItemsProcessed(state.iterations() * grid.height() * grid.width());
+}
+BENCHMARK(BM_Day4CountXmasBands)->Apply(sizes)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,177 @@
+#include "exec/pool.h"
+
+#include <algorithm>
+
+struct ThreadPool::Job
+{
+  const std::function<void(size_t, size_t)>* body;
+  std::atomic<size_t> remaining{0};
+  std::mutex mutex;
+  std::condition_variable done;
+  bool finished = false;
+  std::exception_ptr error;
+};
+
+namespace {
+
+// Queue index of the current thread within the pool it works for. Threads
+// that are not pool workers (e.g. main) use the extra queue at the end.
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // One queue per worker plus one shared by outside callers
+    for (unsigned i = 0; i < threads; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 0; i + 1 < threads; i++) {
+        workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+size_t ThreadPool::chunk_size(size_t count, size_t grain) const
+{
+    if (grain > 0) {
+        return grain;
+    }
+    // About eight chunks per thread leaves room for stealing to even out
+    // chunks of different cost
+    return std::max<size_t>(count / (size_t(size()) * 8), 1);
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain,
+                              const std::function<void(size_t, size_t)>& body)
+{
+    if (begin >= end) {
+        return;
+    }
+    grain = chunk_size(end - begin, grain);
+    size_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks == 1 || workers.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.remaining = chunks;
+
+    // Count the chunks before publishing them so no thread sees a chunk it
+    // has not been told about
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending += chunks;
+    }
+    // Deal the chunks out round robin, starting with the caller's own queue
+    size_t self = currentPool == this ? currentQueue : queues.size() - 1;
+    for (size_t c = 0; c < chunks; c++) {
+        size_t chunkBegin = begin + c * grain;
+        Task task{&job, chunkBegin, std::min(chunkBegin + grain, end)};
+        Queue& queue = *queues[(self + c) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    wake.notify_all();
+
+    // Help out until no chunk of this loop is left to take, then wait for
+    // the ones still running elsewhere. The job lives on this stack frame, so
+    // it must not return before the last chunk has signalled it.
+    while (job.remaining.load(std::memory_order_acquire) > 0 && try_run_one(self)) {
+    }
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.done.wait(lock, [&job]() { return job.finished; });
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+bool ThreadPool::try_run_one(size_t self)
+{
+    Task task;
+    bool found = false;
+    {
+        // Own work first, newest chunk first since it is likely still cached
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (size_t i = 1; !found && i < queues.size(); i++) {
+        // Steal the oldest chunk from someone else
+        Queue& victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    pending--;
+    run(task);
+    return true;
+}
+
+void ThreadPool::run(const Task& task)
+{
+    Job& job = *task.job;
+    try {
+        (*job.body)(task.begin, task.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (!job.error) {
+            job.error = std::current_exception();
+        }
+    }
+    if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        job.finished = true;
+        job.done.notify_all();
+    }
+}
+
+void ThreadPool::worker_loop(size_t self)
+{
+    currentPool = this;
+    currentQueue = self;
+    while (true) {
+        if (try_run_one(self)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || pending.load() > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef EXEC_POOL_H_
+#define EXEC_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for data-parallel loops over index ranges.
+//
+// parallel_for() cuts [begin, end) into grain-sized chunks and deals them out
+// to per-worker deques. Each worker pops from the back of its own deque and,
+// once that is empty, steals from the front of the others, so uneven chunks
+// are balanced dynamically. The calling thread helps run chunks until its
+// loop is finished, which also makes nested loops safe.
+class ThreadPool
+{
+public:
+  // threads counts the calling thread, so ThreadPool(1) runs everything
+  // inline. 0 means one thread per hardware thread.
+  explicit ThreadPool(unsigned threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Threads that run loop bodies, including the caller
+  unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+  // Calls body(chunkBegin, chunkEnd) for disjoint chunks covering
+  // [begin, end). grain 0 picks a chunk size that gives each thread several
+  // chunks to balance with. Rethrows the first exception a body throws.
+  void parallel_for(size_t begin, size_t end, size_t grain,
+                    const std::function<void(size_t, size_t)>& body);
+
+  // Maps each chunk to a partial result and folds the partials left to
+  // right with combine, so combine only has to be associative.
+  template <typename R, typename Map, typename Combine>
+  R parallel_reduce(size_t begin, size_t end, size_t grain, R identity, Map map, Combine combine)
+  {
+    if (begin >= end) {
+      return identity;
+    }
+    grain = chunk_size(end - begin, grain);
+    size_t chunks = (end - begin + grain - 1) / grain;
+    std::vector<R> partials(chunks, identity);
+    parallel_for(0, chunks, 1, [&](size_t first, size_t last) {
+      for (size_t c = first; c < last; c++) {
+        size_t chunkBegin = begin + c * grain;
+        size_t chunkEnd = chunkBegin + grain < end ? chunkBegin + grain : end;
+        partials[c] = map(chunkBegin, chunkEnd);
+      }
+    });
+    R result = identity;
+    for (R& partial : partials) {
+      result = combine(result, partial);
+    }
+    return result;
+  }
+
+  // Process-wide pool sized to the hardware
+  static ThreadPool& shared();
+
+private:
+  struct Job;
+  struct Task
+  {
+    Job* job;
+    size_t begin;
+    size_t end;
+  };
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  size_t chunk_size(size_t count, size_t grain) const;
+  bool try_run_one(size_t self);
+  void run(const Task& task);
+  void worker_loop(size_t self);
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<size_t> pending{0};
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+  bool stopping = false;
+};
+
+#endif  // EXEC_POOL_H_
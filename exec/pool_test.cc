@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "exec/pool.h"
+
+TEST(ThreadPool, ParallelForCoversEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(10007);
+
+    pool.parallel_for(0, hits.size(), 0, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            hits[i]++;
+        }
+    });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPool, ParallelReduceFoldsInOrder) {
+    ThreadPool pool(4);
+
+    // String concatenation is associative but not commutative
+    std::string result = pool.parallel_reduce(
+        0, 26, 3, std::string(),
+        [](size_t begin, size_t end) {
+            std::string part;
+            for (size_t i = begin; i < end; i++) {
+                part += static_cast<char>('a' + i);
+            }
+            return part;
+        },
+        [](const std::string& a, const std::string& b) { return a + b; });
+
+    EXPECT_EQ(result, "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(ThreadPool, ParallelReduceSum) {
+    ThreadPool pool(3);
+    long long sum = pool.parallel_reduce(
+        1, 100001, 0, 0LL,
+        [](size_t begin, size_t end) {
+            long long part = 0;
+            for (size_t i = begin; i < end; i++) {
+                part += i;
+            }
+            return part;
+        },
+        std::plus<>());
+    EXPECT_EQ(sum, 5000050000LL);
+}
+
+TEST(ThreadPool, NestedLoops) {
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+
+    pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+        pool.parallel_for(0, 100, 7, [&](size_t begin, size_t end) {
+            count += static_cast<int>(end - begin);
+        });
+    });
+
+    EXPECT_EQ(count.load(), 800);
+}
+
+TEST(ThreadPool, RethrowsExceptions) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallel_for(0, 100, 1, [](size_t begin, size_t) {
+        if (begin == 42) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+}
+
+TEST(ThreadPool, SingleThreadRunsInline) {
+    ThreadPool pool(1);
+    EXPECT_EQ(pool.size(), 1);
+    int sum = pool.parallel_reduce(0, 10, 2, 0,
+        [](size_t begin, size_t end) { return static_cast<int>(end - begin); },
+        std::plus<>());
+    EXPECT_EQ(sum, 10);
+}
@@ -1,10 +1,25 @@
 #include "flags/file_setup.h"
 #include <unistd.h>  // for getcwd
 #include <cstdlib>   // for exit
+#include <algorithm>
+#include <thread>
 
-ABSL_FLAG(std::string, filename, "test_data.txt", "Filename to process");
+ABSL_FLAG(std::string, filename, "test_data.txt", "Filename to process ('-' reads stdin)");
+ABSL_FLAG(int, threads, 0, "Worker threads (0 = one per hardware thread)");
+ABSL_FLAG(int64_t, buffer_size, 16 << 20, "Buffer size in bytes for streaming inputs");
 
-std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& target_dir)
+unsigned thread_count()
+{
+    int threads = absl::GetFlag(FLAGS_threads);
+    if (threads > 0)
+    {
+        return static_cast<unsigned>(threads);
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// Parses the command line and resolves --filename against target_dir
+static std::filesystem::path setup_file_path(int argc, char *argv[], const std::string& target_dir)
 {
     absl::ParseCommandLine(argc, argv); // Initialize Abseil Flags
 
@@ -19,6 +34,11 @@ std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& tar
         exit(1);
     }
 
+    if (filename == "-")
+    {
+        return "/dev/stdin";
+    }
+
     char cwd[1024];
     if (getcwd(cwd, sizeof(cwd)) != nullptr)
     {
@@ -33,6 +53,12 @@ std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& tar
     // Use the target directory parameter
     std::filesystem::path file_path = std::filesystem::current_path() / target_dir / filename;
     std::cout << "File path: " << file_path << std::endl;
+    return file_path;
+}
+
+std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& target_dir)
+{
+    std::filesystem::path file_path = setup_file_path(argc, argv, target_dir);
     std::ifstream file_stream(file_path.string());
 
     if (!file_stream.is_open())
@@ -44,3 +70,34 @@ std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& tar
     std::cerr << "File opened successfully." << std::endl;
     return file_stream;
 }
+
+InputSource setup_and_map_file(int argc, char *argv[], const std::string& target_dir)
+{
+    std::filesystem::path file_path = setup_file_path(argc, argv, target_dir);
+    InputSource input(file_path.string());
+
+    if (!input.is_open())
+    {
+        std::cerr << "Unable to open file: " << file_path << std::endl;
+        exit(1);
+    }
+
+    std::cerr << "File " << (input.mapped() ? "mapped" : "read") << " successfully." << std::endl;
+    return input;
+}
+
+StreamReader setup_and_stream_file(int argc, char *argv[], const std::string& target_dir)
+{
+    std::filesystem::path file_path = setup_file_path(argc, argv, target_dir);
+    size_t buffer_size = static_cast<size_t>(std::max<int64_t>(absl::GetFlag(FLAGS_buffer_size), 4096));
+    StreamReader reader(file_path.string(), buffer_size);
+
+    if (!reader.is_open())
+    {
+        std::cerr << "Unable to open file: " << file_path << std::endl;
+        exit(1);
+    }
+
+    std::cerr << "File opened for streaming." << std::endl;
+    return reader;
+}
@@ -3,14 +3,27 @@
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
+#include "flags/input_source.h"
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <filesystem>
 #include <fstream>
 
 ABSL_DECLARE_FLAG(std::string, filename);
+ABSL_DECLARE_FLAG(int, threads);
+ABSL_DECLARE_FLAG(int64_t, buffer_size);
+
+// Value of --threads, with 0 resolved to the hardware concurrency
+unsigned thread_count();
 
 std::ifstream setup_and_open_file(int argc, char *argv[], const std::string& target_dir);
 
+// Like setup_and_open_file, but maps the file instead of opening a stream
+InputSource setup_and_map_file(int argc, char *argv[], const std::string& target_dir);
+
+// Opens the file for reading in --buffer_size windows
+StreamReader setup_and_stream_file(int argc, char *argv[], const std::string& target_dir);
+
 #endif  // FLAGS_FILE_SETUP_H_
@@ -0,0 +1,37 @@
+#include "flags/file_setup.h"
+#include "flags/trace.h"
+#include "table/columnar_table.h"
+
+#include <exception>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+int process(ColumnarTable<int> table);
+
+int main(int argc, char *argv[])
+{
+    ScopedPhase open_phase("open");
+    InputSource input = setup_and_map_file(argc, argv, TARGET_DIR);
+    // A mapped file is read later, by whoever touches the pages
+    open_phase.end(input.mapped() ? 0 : input.size());
+
+    ScopedPhase parse_phase("parse", input.size());
+    ColumnarTable<int> table;
+    try {
+        table = ColumnarTable<int>(input.view());
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to parse input: " << e.what() << std::endl;
+        // Ended here so the failed parse is in the trace
+        parse_phase.end();
+        return finish_trace(1);
+    }
+    parse_phase.end();
+
+    std::cerr << "Table read successfully." << std::endl;
+
+    ScopedPhase process_phase("process", input.size());
+    int result = process(std::move(table));
+    process_phase.end();
+    return finish_trace(result);
+}
@@ -0,0 +1,68 @@
+#include "flags/file_setup.h"
+#include "flags/trace.h"
+
+#include <iostream>
+#include <string_view>
+
+// Streams the input file named by the flags through process_window, then
+// calls finish, and returns the exit code. The callbacks carry whatever state
+// the caller gives them, so that state can live in the caller's main:
+//
+//   size_t process_window(std::string_view buffer, bool last)
+//
+// gets consecutive windows of the input, each at most --buffer_size bytes
+// (plus any unconsumed tail). It returns how many bytes from the front of
+// buffer it used up; the rest is carried over to the front of the next
+// window, so a token split across two reads can be finished there. last is
+// set for the final window, which should be consumed entirely.
+//
+//   int finish()
+//
+// runs after the last window and returns the exit code.
+template <typename ProcessWindow, typename Finish>
+int run_stream(int argc, char *argv[], ProcessWindow process_window, Finish finish)
+{
+    ScopedPhase open_phase("open");
+    StreamReader reader = setup_and_stream_file(argc, argv, TARGET_DIR);
+    open_phase.end();
+
+    // Every window adds to one read and one process phase, so tracing a
+    // stream takes constant memory however long it is
+    ScopedPhase read_phase("read");
+    ScopedPhase process_phase("process");
+    process_phase.pause();
+    size_t consumed = 0;
+    while (true)
+    {
+        size_t before = reader.bytes_read();
+        read_phase.resume();
+        std::string_view buffer = reader.next(consumed);
+        read_phase.pause();
+        read_phase.add_bytes(reader.bytes_read() - before);
+        bool last = reader.eof();
+
+        process_phase.resume();
+        consumed = process_window(buffer, last);
+        process_phase.pause();
+        // Carried-over bytes are only counted once
+        process_phase.add_bytes(last ? buffer.size() : consumed);
+        if (last)
+        {
+            break;
+        }
+    }
+    read_phase.end();
+    process_phase.end();
+
+    if (!reader.is_open())
+    {
+        std::cerr << "Error while reading input." << std::endl;
+        return finish_trace(1);
+    }
+    std::cerr << "Streamed " << reader.bytes_read() << " bytes." << std::endl;
+
+    ScopedPhase finish_phase("finish");
+    int result = finish();
+    finish_phase.end();
+    return finish_trace(result);
+}
@@ -1,23 +1,24 @@
 #include "flags/file_setup.h"
+#include "flags/trace.h"
 
 #include <iostream>
 #include <vector>
 #include <numeric>
 #include <string>
-#include <sstream>
+#include <string_view>
 
-int process(const std::string& content);
+int process(std::string_view content);
 
 int main(int argc, char *argv[])
 {
-    std::ifstream file_stream = setup_and_open_file(argc, argv, TARGET_DIR);
-    
-    // Read entire file content into a string
-    std::stringstream buffer;
-    buffer << file_stream.rdbuf();
-    std::string content = buffer.str();
+    // The mapped file is handed to process() as is, without copying it
+    ScopedPhase open_phase("open");
+    InputSource input = setup_and_map_file(argc, argv, TARGET_DIR);
+    // A mapped file is read later, by whoever touches the pages
+    open_phase.end(input.mapped() ? 0 : input.size());
 
-    std::cerr << "File content read successfully." << std::endl;
-
-    return process(content);
+    ScopedPhase process_phase("process", input.size());
+    int result = process(input.view());
+    process_phase.end();
+    return finish_trace(result);
 }
@@ -1,19 +1,28 @@
 #include "flags/file_setup.h"
+#include "flags/trace.h"
 #include "table/table.h"
 
 #include <iostream>
 #include <vector>
 #include <numeric>
 
-int process(Table<char> table);
+int process(const Table<char>& table);
 
 int main(int argc, char *argv[])
 {
-    std::ifstream file_stream = setup_and_open_file(argc, argv, TARGET_DIR);
-    auto parsed_data = parseTable<char>(file_stream);
-    Table<char> table(parsed_data);
+    ScopedPhase open_phase("open");
+    InputSource input = setup_and_map_file(argc, argv, TARGET_DIR);
+    // A mapped file is read later, by whoever touches the pages
+    open_phase.end(input.mapped() ? 0 : input.size());
+
+    ScopedPhase parse_phase("parse", input.size());
+    Table<char> table = parseTableParallel<char>(input.view(), thread_count());
+    parse_phase.end();
 
     std::cerr << "Table read successfully." << std::endl;
 
-    return process(table);
+    ScopedPhase process_phase("process", input.size());
+    int result = process(table);
+    process_phase.end();
+    return finish_trace(result);
 }
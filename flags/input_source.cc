@@ -0,0 +1,154 @@
+#include "flags/input_source.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Reads everything left on fd into buffer, for inputs that cannot be mapped
+bool read_all(int fd, std::string& buffer)
+{
+    constexpr size_t kChunkSize = 1 << 16;
+    size_t used = 0;
+    while (true) {
+        buffer.resize(used + kChunkSize);
+        ssize_t n = read(fd, &buffer[used], kChunkSize);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            buffer.clear();
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        used += static_cast<size_t>(n);
+    }
+    buffer.resize(used);
+    return true;
+}
+
+}  // namespace
+
+InputSource::InputSource(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            mapping = addr;
+            data = static_cast<const char*>(addr);
+            length = static_cast<size_t>(st.st_size);
+            opened = true;
+            close(fd);
+            return;
+        }
+    }
+
+    // Streaming fallback: pipes, devices, empty files and failed mappings
+    opened = read_all(fd, buffer);
+    data = buffer.data();
+    length = buffer.size();
+    close(fd);
+}
+
+InputSource::~InputSource()
+{
+    release();
+}
+
+InputSource::InputSource(InputSource&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+InputSource& InputSource::operator=(InputSource&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        opened = std::exchange(other.opened, false);
+        mapping = std::exchange(other.mapping, nullptr);
+        length = std::exchange(other.length, 0);
+        buffer = std::move(other.buffer);
+        data = mapping != nullptr ? static_cast<const char*>(mapping) : buffer.data();
+        other.data = nullptr;
+    }
+    return *this;
+}
+
+void InputSource::release()
+{
+    if (mapping != nullptr) {
+        munmap(mapping, length);
+        mapping = nullptr;
+    }
+    buffer.clear();
+    data = nullptr;
+    length = 0;
+    opened = false;
+}
+
+StreamReader::StreamReader(const std::string& path, size_t bufferSize)
+    : buffer(bufferSize > 0 ? bufferSize : 1, '\0')
+{
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+}
+
+StreamReader::~StreamReader()
+{
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+StreamReader::StreamReader(StreamReader&& other) noexcept
+    : fd(std::exchange(other.fd, -1)),
+      atEnd(other.atEnd),
+      failed(other.failed),
+      buffer(std::move(other.buffer)),
+      used(std::exchange(other.used, 0)),
+      totalRead(other.totalRead)
+{
+}
+
+std::string_view StreamReader::next(size_t consumed)
+{
+    consumed = std::min(consumed, used);
+    if (consumed == 0 && used == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+    std::memmove(&buffer[0], buffer.data() + consumed, used - consumed);
+    used -= consumed;
+
+    while (!atEnd && used < buffer.size()) {
+        ssize_t n = read(fd, &buffer[used], buffer.size() - used);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            failed = n < 0;
+            atEnd = true;
+            break;
+        }
+        used += static_cast<size_t>(n);
+        totalRead += static_cast<size_t>(n);
+    }
+    return std::string_view(buffer.data(), used);
+}
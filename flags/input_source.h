@@ -0,0 +1,78 @@
+#ifndef FLAGS_INPUT_SOURCE_H_
+#define FLAGS_INPUT_SOURCE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only view of an input file. Regular files are memory mapped (with
+// MADV_SEQUENTIAL) so the parser reads straight from the page cache without
+// copying. Pipes, character devices and anything mmap refuses fall back to
+// reading the stream into an owned buffer.
+class InputSource
+{
+public:
+  explicit InputSource(const std::string& path);
+  ~InputSource();
+
+  InputSource(InputSource&& other) noexcept;
+  InputSource& operator=(InputSource&& other) noexcept;
+  InputSource(const InputSource&) = delete;
+  InputSource& operator=(const InputSource&) = delete;
+
+  bool is_open() const { return opened; }
+  bool mapped() const { return mapping != nullptr; }
+
+  std::string_view view() const { return std::string_view(data, length); }
+  const char* begin() const { return data; }
+  const char* end() const { return data + length; }
+  size_t size() const { return length; }
+
+private:
+  void release();
+
+  bool opened = false;
+  void* mapping = nullptr;
+  const char* data = nullptr;
+  size_t length = 0;
+  std::string buffer;
+};
+
+// Reads an input in windows of a fixed-size buffer, so memory use does not
+// depend on the input size. Works the same for files, pipes and stdin.
+class StreamReader
+{
+public:
+  StreamReader(const std::string& path, size_t bufferSize);
+  ~StreamReader();
+
+  StreamReader(StreamReader&& other) noexcept;
+  StreamReader& operator=(StreamReader&& other) = delete;
+  StreamReader(const StreamReader&) = delete;
+  StreamReader& operator=(const StreamReader&) = delete;
+
+  bool is_open() const { return fd >= 0 && !failed; }
+
+  // Drops the first consumed bytes of the current window, moves the rest to
+  // the front of the buffer and fills it up from the input. Returns the new
+  // window. If nothing was consumed from a full buffer, the buffer doubles
+  // so the window always grows.
+  std::string_view next(size_t consumed);
+
+  // True once the input is exhausted, i.e. the last window returned by
+  // next() ends at the end of the input
+  bool eof() const { return atEnd; }
+
+  // Total bytes read from the input so far
+  size_t bytes_read() const { return totalRead; }
+
+private:
+  int fd = -1;
+  bool atEnd = false;
+  bool failed = false;
+  std::string buffer;
+  size_t used = 0;
+  size_t totalRead = 0;
+};
+
+#endif  // FLAGS_INPUT_SOURCE_H_
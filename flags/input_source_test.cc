@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "flags/input_source.h"
+
+// Writes content to a fresh temporary file and returns its path
+static std::string writeTempFile(const std::string& content) {
+    char path[] = "/tmp/input_source_test_XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+    close(fd);
+    return path;
+}
+
+TEST(InputSource, MapsRegularFiles) {
+    std::string path = writeTempFile("1 2\n3 4\n");
+    InputSource input(path);
+
+    ASSERT_TRUE(input.is_open());
+    EXPECT_TRUE(input.mapped());
+    EXPECT_EQ(input.view(), "1 2\n3 4\n");
+
+    InputSource moved(std::move(input));
+    EXPECT_EQ(moved.view(), "1 2\n3 4\n");
+    std::remove(path.c_str());
+}
+
+TEST(InputSource, ReadsEmptyAndMissingFiles) {
+    std::string path = writeTempFile("");
+    InputSource empty(path);
+    EXPECT_TRUE(empty.is_open());
+    EXPECT_EQ(empty.size(), 0);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(InputSource("/nonexistent/input").is_open());
+}
+
+TEST(StreamReader, CarriesUnconsumedTail) {
+    std::string path = writeTempFile("abcdefghij");
+    StreamReader reader(path, 4);
+    ASSERT_TRUE(reader.is_open());
+
+    EXPECT_EQ(reader.next(0), "abcd");
+    EXPECT_FALSE(reader.eof());
+    EXPECT_EQ(reader.next(3), "defg");
+    // Nothing consumed from a full buffer: it grows instead of stalling
+    EXPECT_EQ(reader.next(0), "defghij");
+    EXPECT_TRUE(reader.eof());
+    EXPECT_EQ(reader.bytes_read(), 10);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,209 @@
+#include "flags/trace.h"
+
+#include <sys/resource.h>
+#include <time.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <utility>
+
+#include "absl/flags/flag.h"
+
+ABSL_FLAG(bool, timing, false, "Print wall/CPU time, bytes and peak RSS per phase to stderr");
+ABSL_FLAG(std::string, trace_json, "", "Write the phases as Chrome trace-event JSON to this file");
+
+namespace
+{
+
+std::mutex phasesMutex;
+std::vector<PhaseRecord> phases;
+
+// Start of the trace, fixed by the first phase
+std::chrono::steady_clock::time_point origin()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+int64_t process_cpu_us()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+int64_t peak_rss_kb()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;  // kilobytes on Linux
+}
+
+// Small stable id per thread for the trace's tid field
+int thread_number()
+{
+    static std::atomic<int> next{1};
+    thread_local int id = next++;
+    return id;
+}
+
+void write_json_string(std::ostream& out, const std::string& text)
+{
+    out << '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+ScopedPhase::ScopedPhase(std::string name, size_t bytes)
+    : name(std::move(name)), bytes(bytes)
+{
+    origin();
+    first = start = std::chrono::steady_clock::now();
+    cpuStart = process_cpu_us();
+}
+
+ScopedPhase::~ScopedPhase()
+{
+    end();
+}
+
+void ScopedPhase::pause()
+{
+    if (!running || paused)
+    {
+        return;
+    }
+    paused = true;
+    wall += std::chrono::steady_clock::now() - start;
+    cpu += process_cpu_us() - cpuStart;
+}
+
+void ScopedPhase::resume()
+{
+    if (!running || !paused)
+    {
+        return;
+    }
+    paused = false;
+    start = std::chrono::steady_clock::now();
+    cpuStart = process_cpu_us();
+}
+
+void ScopedPhase::end(size_t bytes)
+{
+    this->bytes = bytes;
+    end();
+}
+
+void ScopedPhase::end()
+{
+    if (!running)
+    {
+        return;
+    }
+    pause();
+    running = false;
+    // Checked here rather than on construction: the first phases start
+    // before the flags are parsed
+    if (!absl::GetFlag(FLAGS_timing) && absl::GetFlag(FLAGS_trace_json).empty())
+    {
+        return;
+    }
+    PhaseRecord record;
+    record.name = std::move(name);
+    record.start_us = std::chrono::duration_cast<std::chrono::microseconds>(first - origin()).count();
+    record.wall_us = std::chrono::duration_cast<std::chrono::microseconds>(wall).count();
+    record.cpu_us = cpu;
+    record.bytes = bytes;
+    record.peak_rss_kb = peak_rss_kb();
+    record.thread = thread_number();
+
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    phases.push_back(std::move(record));
+}
+
+std::vector<PhaseRecord> recorded_phases()
+{
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    return phases;
+}
+
+void write_trace_json(std::ostream& out)
+{
+    std::vector<PhaseRecord> records = recorded_phases();
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const PhaseRecord& record = records[i];
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        write_json_string(out, record.name);
+        out << ",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.thread
+            << ",\"ts\":" << record.start_us << ",\"dur\":" << record.wall_us
+            << ",\"args\":{\"cpu_us\":" << record.cpu_us << ",\"bytes\":" << record.bytes
+            << ",\"peak_rss_kb\":" << record.peak_rss_kb << "}}";
+    }
+    out << "\n]}\n";
+}
+
+int finish_trace(int exit_code)
+{
+    if (absl::GetFlag(FLAGS_timing))
+    {
+        std::vector<PhaseRecord> records = recorded_phases();
+        std::cerr << std::left << std::setw(16) << "phase" << std::right << std::setw(12) << "wall ms"
+                  << std::setw(12) << "cpu ms" << std::setw(12) << "MB" << std::setw(12) << "MB/s"
+                  << std::setw(14) << "peak RSS MB" << std::endl;
+        std::cerr << std::fixed << std::setprecision(2);
+        for (const PhaseRecord& record : records)
+        {
+            double mb = record.bytes / 1e6;
+            std::cerr << std::left << std::setw(16) << record.name << std::right
+                      << std::setw(12) << record.wall_us / 1e3 << std::setw(12) << record.cpu_us / 1e3
+                      << std::setw(12) << mb;
+            if (record.bytes > 0 && record.wall_us > 0)
+            {
+                std::cerr << std::setw(12) << mb / (record.wall_us / 1e6);
+            }
+            else
+            {
+                std::cerr << std::setw(12) << "-";
+            }
+            std::cerr << std::setw(14) << record.peak_rss_kb / 1024.0 << std::endl;
+        }
+    }
+
+    std::string path = absl::GetFlag(FLAGS_trace_json);
+    if (!path.empty())
+    {
+        std::ofstream out(path);
+        write_trace_json(out);
+        if (!out)
+        {
+            std::cerr << "Unable to write trace to " << path << std::endl;
+            return exit_code == 0 ? 1 : exit_code;
+        }
+    }
+    return exit_code;
+}
@@ -0,0 +1,78 @@
+#ifndef FLAGS_TRACE_H_
+#define FLAGS_TRACE_H_
+
+#include "absl/flags/declare.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+ABSL_DECLARE_FLAG(bool, timing);
+ABSL_DECLARE_FLAG(std::string, trace_json);
+
+// One finished phase of a run. Times are in microseconds, start_us counted
+// from the first phase of the process.
+struct PhaseRecord
+{
+  std::string name;
+  int64_t start_us = 0;
+  int64_t wall_us = 0;
+  int64_t cpu_us = 0;  // CPU time of the whole process, all threads
+  size_t bytes = 0;
+  int64_t peak_rss_kb = 0;  // high-water mark when the phase ended
+  int thread = 0;
+};
+
+// Times a phase of a run from construction until end() or destruction and
+// records its wall and CPU time, the bytes it handled and the peak RSS.
+// Phases are only recorded when --timing or --trace_json is set; otherwise a
+// phase costs two clock reads and nothing is kept.
+class ScopedPhase
+{
+public:
+  explicit ScopedPhase(std::string name, size_t bytes = 0);
+  ~ScopedPhase();
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+  void set_bytes(size_t bytes) { this->bytes = bytes; }
+  void add_bytes(size_t bytes) { this->bytes += bytes; }
+
+  // Stops the clocks until resume(), so one phase can total many short
+  // spans, e.g. every read of a streamed input
+  void pause();
+  void resume();
+
+  // Ends the phase early; the destructor then does nothing
+  void end();
+  void end(size_t bytes);
+
+private:
+  std::string name;
+  size_t bytes;
+  std::chrono::steady_clock::time_point first;
+  std::chrono::steady_clock::time_point start;
+  int64_t cpuStart;
+  std::chrono::steady_clock::duration wall{};
+  int64_t cpu = 0;
+  bool running = true;
+  bool paused = false;
+};
+
+// Phases recorded so far, in the order they ended
+std::vector<PhaseRecord> recorded_phases();
+
+// Chrome trace-event JSON for the recorded phases, loadable in
+// chrome://tracing or Perfetto
+void write_trace_json(std::ostream& out);
+
+// Prints a --timing summary to stderr and writes --trace_json, as the flags
+// ask, then returns exit_code so mains can end with
+// `return finish_trace(process(...));`
+int finish_trace(int exit_code);
+
+#endif  // FLAGS_TRACE_H_
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "absl/flags/flag.h"
+#include "flags/trace.h"
+
+TEST(Trace, RecordsPhasesInOrder) {
+    absl::SetFlag(&FLAGS_trace_json, "");
+    absl::SetFlag(&FLAGS_timing, true);
+    size_t before = recorded_phases().size();
+    {
+        ScopedPhase outer("outer", 100);
+        ScopedPhase inner("inner");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        inner.end(42);
+        inner.end(7);  // already ended
+    }
+    std::vector<PhaseRecord> phases = recorded_phases();
+    ASSERT_EQ(phases.size(), before + 2);
+    const PhaseRecord& inner = phases[before];
+    const PhaseRecord& outer = phases[before + 1];
+    EXPECT_EQ(inner.name, "inner");
+    EXPECT_EQ(inner.bytes, 42u);
+    EXPECT_GE(inner.wall_us, 2000);
+    EXPECT_EQ(outer.name, "outer");
+    EXPECT_EQ(outer.bytes, 100u);
+    EXPECT_LE(outer.start_us, inner.start_us);
+    EXPECT_GE(outer.wall_us, inner.wall_us);
+    EXPECT_GT(outer.peak_rss_kb, 0);
+    EXPECT_GE(outer.cpu_us, 0);
+}
+
+TEST(Trace, WritesChromeTraceEvents) {
+    absl::SetFlag(&FLAGS_timing, true);
+    {
+        ScopedPhase phase("quote \"and\" slash\\", 5);
+    }
+    std::ostringstream out;
+    write_trace_json(out);
+    std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"quote \\\"and\\\" slash\\\\\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"bytes\":5"), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+TEST(Trace, RecordsNothingWithoutFlags) {
+    absl::SetFlag(&FLAGS_timing, false);
+    absl::SetFlag(&FLAGS_trace_json, "");
+    size_t before = recorded_phases().size();
+    for (int i = 0; i < 100; i++) {
+        ScopedPhase phase("window", 10);
+    }
+    EXPECT_EQ(recorded_phases().size(), before);
+}
+
+TEST(Trace, PausedPhaseTotalsItsSpans) {
+    absl::SetFlag(&FLAGS_timing, true);
+    size_t before = recorded_phases().size();
+    {
+        ScopedPhase phase("windows");
+        for (int i = 0; i < 3; i++) {
+            phase.resume();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            phase.add_bytes(10);
+            phase.pause();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    std::vector<PhaseRecord> phases = recorded_phases();
+    ASSERT_EQ(phases.size(), before + 1);
+    EXPECT_EQ(phases[before].bytes, 30u);
+    EXPECT_GE(phases[before].wall_us, 6000);
+    // The paused time is left out
+    EXPECT_LT(phases[before].wall_us, 60000);
+}
+
+TEST(Trace, FinishPassesExitCodeThrough) {
+    absl::SetFlag(&FLAGS_timing, false);
+    EXPECT_EQ(finish_trace(0), 0);
+    EXPECT_EQ(finish_trace(3), 3);
+}
@@ -0,0 +1,49 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "gen/generators.h"
+
+ABSL_FLAG(std::string, format, "", "Input format: two_columns, reports, memory, grid or rules");
+ABSL_FLAG(int64_t, bytes, 1 << 20, "Approximate size of the generated input in bytes");
+ABSL_FLAG(uint64_t, seed, kDefaultSeed, "Random seed; the same seed gives the same input");
+ABSL_FLAG(std::string, output, "-", "File to write ('-' writes stdout)");
+
+// Writes a synthetic puzzle input, e.g.
+//   bazel run //gen:generate -- --format=reports --bytes=1000000000 --output=/tmp/reports.txt
+int main(int argc, char* argv[])
+{
+    absl::ParseCommandLine(argc, argv);
+
+    InputFormat format;
+    if (!parseInputFormat(absl::GetFlag(FLAGS_format), format))
+    {
+        std::cerr << "Unknown --format: '" << absl::GetFlag(FLAGS_format) << "'" << std::endl;
+        exit(1);
+    }
+    int64_t bytes = absl::GetFlag(FLAGS_bytes);
+    if (bytes < 0)
+    {
+        std::cerr << "--bytes must not be negative" << std::endl;
+        exit(1);
+    }
+
+    std::string output = absl::GetFlag(FLAGS_output);
+    std::ofstream file;
+    if (output != "-")
+    {
+        file.open(output, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open " << output << std::endl;
+            exit(1);
+        }
+    }
+    std::ostream& out = output == "-" ? std::cout : file;
+    generateInput(format, static_cast<size_t>(bytes), absl::GetFlag(FLAGS_seed), out);
+    out.flush();
+    return out.good() ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+#include "gen/generators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Collects output in blocks and counts what has been written
+class Writer {
+public:
+    explicit Writer(std::ostream& out) : out(out) { buffer.reserve(kBlock + 256); }
+    ~Writer() { flush(); }
+
+    void put(char c) {
+        buffer += c;
+        maybeFlush();
+    }
+    void put(std::string_view text) {
+        buffer += text;
+        maybeFlush();
+    }
+    void put(int value) { put(std::string_view(std::to_string(value))); }
+
+    size_t written() const { return flushed + buffer.size(); }
+
+    void flush() {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        flushed += buffer.size();
+        buffer.clear();
+    }
+
+private:
+    static constexpr size_t kBlock = 1 << 20;
+
+    void maybeFlush() {
+        if (buffer.size() >= kBlock) {
+            flush();
+        }
+    }
+
+    std::ostream& out;
+    std::string buffer;
+    size_t flushed = 0;
+};
+
+class Random {
+public:
+    explicit Random(uint64_t seed) : engine(seed) {}
+
+    // In [low, high]. Plain modulo rather than std::uniform_int_distribution,
+    // whose output differs between standard libraries.
+    int between(int low, int high) {
+        return low + static_cast<int>(engine() % static_cast<uint64_t>(high - low + 1));
+    }
+    bool chance(int percent) { return between(1, 100) <= percent; }
+
+    template <typename T>
+    void shuffle(std::vector<T>& items) {
+        for (size_t i = items.size(); i > 1; i--) {
+            std::swap(items[i - 1], items[between(0, static_cast<int>(i) - 1)]);
+        }
+    }
+
+private:
+    std::mt19937_64 engine;
+};
+
+void twoColumns(size_t bytes, Random& rng, Writer& out) {
+    while (out.written() < bytes) {
+        out.put(rng.between(10000, 99999));
+        out.put("   ");
+        out.put(rng.between(10000, 99999));
+        out.put('\n');
+    }
+}
+
+void reports(size_t bytes, Random& rng, Writer& out) {
+    while (out.written() < bytes) {
+        int length = rng.between(5, 8);
+        int direction = rng.chance(50) ? 1 : -1;
+        int level = direction > 0 ? rng.between(10, 40) : rng.between(60, 99);
+        // A quarter of the rows get one step that breaks the rules
+        int badStep = rng.chance(25) ? rng.between(1, length - 1) : -1;
+        for (int i = 0; i < length; i++) {
+            if (i > 0) {
+                out.put(' ');
+                int step = direction * rng.between(1, 3);
+                if (i == badStep) {
+                    step = rng.chance(50) ? 0 : -step * rng.between(1, 2);
+                }
+                level += step;
+            }
+            out.put(level);
+        }
+        out.put('\n');
+    }
+}
+
+void memory(size_t bytes, Random& rng, Writer& out) {
+    static const std::string_view kJunk = "!@#$%^&*()[]{}<>+-_=?/'~ ,;:mdulotwhe";
+    static const std::string_view kNearMisses[] = {
+        "mul(4*", "mul[3,7]", "mul ( 2 , 4 )", "mul(32,64]", "don't", "do(", "mul(1234,5)", "?mul(8,",
+    };
+    size_t lineLength = 0;
+    while (out.written() < bytes) {
+        int roll = rng.between(0, 99);
+        if (roll < 20) {
+            out.put("mul(");
+            out.put(rng.between(0, 999));
+            out.put(',');
+            out.put(rng.between(0, 999));
+            out.put(')');
+        } else if (roll < 23) {
+            out.put("do()");
+        } else if (roll < 26) {
+            out.put("don't()");
+        } else if (roll < 36) {
+            out.put(kNearMisses[rng.between(0, static_cast<int>(std::size(kNearMisses)) - 1)]);
+        } else {
+            out.put(kJunk[rng.between(0, static_cast<int>(kJunk.size()) - 1)]);
+        }
+        // The real inputs are a few lines of a few thousand bytes
+        if (++lineLength >= 1000) {
+            out.put('\n');
+            lineLength = 0;
+        }
+    }
+    out.put('\n');
+}
+
+void grid(size_t bytes, Random& rng, Writer& out) {
+    size_t width = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(bytes))));
+    while (width > 1 && width * (width + 1) > bytes) {
+        width--;
+    }
+    for (size_t r = 0; r < width; r++) {
+        for (size_t c = 0; c < width; c++) {
+            out.put("XMAS"[rng.between(0, 3)]);
+        }
+        out.put('\n');
+    }
+}
+
+// Pages are ranked by a hidden total order and every ordered pair becomes a
+// rule, so each update has exactly one valid ordering. Half the updates are
+// written in that order and half shuffled.
+void rules(size_t bytes, Random& rng, Writer& out) {
+    // About a quarter of the output goes to rules, at six bytes per rule
+    int pages = static_cast<int>(std::sqrt(static_cast<double>(bytes) / 12));
+    pages = std::clamp(pages, 5, 90);
+    std::vector<int> order(pages);
+    for (int i = 0; i < pages; i++) {
+        order[i] = 10 + i;
+    }
+    rng.shuffle(order);
+
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(pages * (pages - 1) / 2);
+    for (int i = 0; i < pages; i++) {
+        for (int j = i + 1; j < pages; j++) {
+            pairs.emplace_back(order[i], order[j]);
+        }
+    }
+    rng.shuffle(pairs);
+    for (const auto& [before, after] : pairs) {
+        out.put(before);
+        out.put('|');
+        out.put(after);
+        out.put('\n');
+    }
+    out.put('\n');
+
+    int longest = std::min(23, pages % 2 ? pages : pages - 1);
+    std::vector<int> ranks(pages);
+    for (int i = 0; i < pages; i++) {
+        ranks[i] = i;
+    }
+    do {
+        int length = rng.between(2, longest / 2) * 2 + 1;
+        if (length > longest) {
+            length = longest;
+        }
+        // Partial shuffle picks `length` distinct ranks
+        for (int i = 0; i < length; i++) {
+            std::swap(ranks[i], ranks[rng.between(i, pages - 1)]);
+        }
+        std::vector<int> update(ranks.begin(), ranks.begin() + length);
+        if (rng.chance(50)) {
+            std::sort(update.begin(), update.end());
+        } else {
+            rng.shuffle(update);
+        }
+        for (int i = 0; i < length; i++) {
+            if (i > 0) {
+                out.put(',');
+            }
+            out.put(order[update[i]]);
+        }
+        out.put('\n');
+    } while (out.written() < bytes);
+}
+
+}  // namespace
+
+bool parseInputFormat(std::string_view name, InputFormat& format) {
+    static const std::pair<std::string_view, InputFormat> kNames[] = {
+        {"two_columns", InputFormat::TWO_COLUMNS},
+        {"reports", InputFormat::REPORTS},
+        {"memory", InputFormat::MEMORY},
+        {"grid", InputFormat::GRID},
+        {"rules", InputFormat::RULES},
+    };
+    for (const auto& [candidate, value] : kNames) {
+        if (candidate == name) {
+            format = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void generateInput(InputFormat format, size_t bytes, uint64_t seed, std::ostream& out) {
+    Random rng(seed);
+    Writer writer(out);
+    switch (format) {
+        case InputFormat::TWO_COLUMNS:
+            twoColumns(bytes, rng, writer);
+            break;
+        case InputFormat::REPORTS:
+            reports(bytes, rng, writer);
+            break;
+        case InputFormat::MEMORY:
+            memory(bytes, rng, writer);
+            break;
+        case InputFormat::GRID:
+            grid(bytes, rng, writer);
+            break;
+        case InputFormat::RULES:
+            rules(bytes, rng, writer);
+            break;
+    }
+}
+
+std::string generateInput(InputFormat format, size_t bytes, uint64_t seed) {
+    std::ostringstream out;
+    generateInput(format, bytes, seed, out);
+    return out.str();
+}
@@ -0,0 +1,33 @@
+#ifndef GENERATORS_H_
+#define GENERATORS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Puzzle input formats the generators can write
+enum class InputFormat {
+    TWO_COLUMNS,  // day 1: "a   b" pairs of five-digit ints
+    REPORTS,      // day 2: rows of 5 to 8 levels, most of them near-safe
+    MEMORY,       // day 3: mul(X,Y), do() and don't() among corrupted bytes
+    GRID,         // day 4: square grid of X, M, A and S
+    RULES,        // day 5: "a|b" rules, a blank line, "a,b,c" updates
+};
+
+constexpr uint64_t kDefaultSeed = 2024;
+
+// Format from its flag name: two_columns, reports, memory, grid or rules
+bool parseInputFormat(std::string_view name, InputFormat& format);
+
+// Writes a valid input of about `bytes` bytes: generation stops after the
+// first whole line (or, for memory, instruction) that reaches the size.
+// The same format, size and seed always give the same output. Writes in
+// blocks, so sizes well beyond memory are fine.
+void generateInput(InputFormat format, size_t bytes, uint64_t seed, std::ostream& out);
+
+// In-memory version for tests and benchmarks
+std::string generateInput(InputFormat format, size_t bytes, uint64_t seed = kDefaultSeed);
+
+#endif  // GENERATORS_H_
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "3/instructions.h"
+#include "gen/generators.h"
+#include "table/columnar_table.h"
+#include "table/table.h"
+
+static const InputFormat kFormats[] = {
+    InputFormat::TWO_COLUMNS, InputFormat::REPORTS, InputFormat::MEMORY, InputFormat::GRID, InputFormat::RULES,
+};
+
+TEST(Generators, SameSeedSameOutput) {
+    for (InputFormat format : kFormats) {
+        EXPECT_EQ(generateInput(format, 5000, 7), generateInput(format, 5000, 7));
+        EXPECT_NE(generateInput(format, 5000, 7), generateInput(format, 5000, 8));
+    }
+}
+
+TEST(Generators, SizeIsClose) {
+    for (InputFormat format : kFormats) {
+        for (size_t bytes : {size_t(1000), size_t(100000), size_t(3) << 20}) {
+            std::string text = generateInput(format, bytes);
+            EXPECT_GE(text.size() + 2 * 1024, bytes) << static_cast<int>(format);
+            EXPECT_LE(text.size(), bytes + 100) << static_cast<int>(format);
+            EXPECT_EQ(text.back(), '\n');
+        }
+    }
+}
+
+TEST(Generators, StreamMatchesString) {
+    // Larger than one output block
+    std::ostringstream out;
+    generateInput(InputFormat::REPORTS, 3 << 20, kDefaultSeed, out);
+    EXPECT_EQ(out.str(), generateInput(InputFormat::REPORTS, 3 << 20));
+}
+
+TEST(Generators, FormatNames) {
+    InputFormat format;
+    EXPECT_TRUE(parseInputFormat("rules", format));
+    EXPECT_EQ(format, InputFormat::RULES);
+    EXPECT_TRUE(parseInputFormat("two_columns", format));
+    EXPECT_EQ(format, InputFormat::TWO_COLUMNS);
+    EXPECT_FALSE(parseInputFormat("columns", format));
+}
+
+TEST(Generators, TwoColumnsAndReportsParse) {
+    ColumnarTable<int> pairs{std::string_view(generateInput(InputFormat::TWO_COLUMNS, 100000))};
+    EXPECT_EQ(pairs.columnCount(), 2u);
+    EXPECT_GT(pairs.size(), 1000u);
+
+    Table<int> reports{std::string_view(generateInput(InputFormat::REPORTS, 100000))};
+    EXPECT_GT(reports.size(), 1000u);
+    for (const Row<int>& row : reports) {
+        EXPECT_GE(row.size(), 5u);
+        EXPECT_LE(row.size(), 8u);
+    }
+}
+
+TEST(Generators, MemoryHasEveryInstruction) {
+    std::string text = generateInput(InputFormat::MEMORY, 100000);
+    size_t counts[3] = {};
+    scanInstructions(text, [&](const Instruction& instruction) { counts[instruction.kind]++; });
+    EXPECT_GT(counts[Instruction::MUL], 100u);
+    EXPECT_GT(counts[Instruction::DO], 10u);
+    EXPECT_GT(counts[Instruction::DONT], 10u);
+}
+
+TEST(Generators, GridIsSquare) {
+    Table<char> grid{std::string_view(generateInput(InputFormat::GRID, 10000))};
+    ASSERT_GT(grid.size(), 90u);
+    for (const Row<char>& row : grid) {
+        EXPECT_EQ(row.size(), grid.size());
+        for (char c : row) {
+            EXPECT_NE(std::string("XMAS").find(c), std::string::npos);
+        }
+    }
+}
+
+TEST(Generators, RulesOrderEveryUpdate) {
+    std::string text = generateInput(InputFormat::RULES, 200000);
+    size_t blank = text.find("\n\n");
+    ASSERT_NE(blank, std::string::npos);
+
+    std::set<std::pair<int, int>> rules;
+    forEachLine(std::string_view(text).substr(0, blank), [&](std::string_view line) {
+        std::vector<int> rule = parseRow<int>(line, '|');
+        ASSERT_EQ(rule.size(), 2u);
+        rules.emplace(rule[0], rule[1]);
+    });
+    size_t ordered = 0;
+    size_t updates = 0;
+    forEachLine(std::string_view(text).substr(blank + 2), [&](std::string_view line) {
+        std::vector<int> update = parseRow<int>(line, ',');
+        EXPECT_EQ(update.size() % 2, 1u);
+        EXPECT_GE(update.size(), 5u);
+        // Every pair of pages is covered by a rule one way or the other
+        bool inOrder = true;
+        for (size_t i = 0; i + 1 < update.size(); i++) {
+            bool forward = rules.count({update[i], update[i + 1]}) > 0;
+            EXPECT_NE(forward, rules.count({update[i + 1], update[i]}) > 0);
+            inOrder = inOrder && forward;
+        }
+        ordered += inOrder;
+        updates++;
+    });
+    EXPECT_GT(updates, 100u);
+    EXPECT_GT(ordered, updates / 4);
+    EXPECT_LT(ordered, updates * 3 / 4);
+}
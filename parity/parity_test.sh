@@ -0,0 +1,79 @@
+#!/bin/bash
+# Runs the C++ and Rust solutions of a day on the same generated inputs,
+# fails if their answers differ, and reports the wall time and throughput
+# of each side by side. The report is also written to parity.tsv in the
+# test's undeclared outputs (or a temp directory outside Bazel).
+#
+# Usage: parity_test.sh GENERATE CPP_1 RUST_1 CPP_5 RUST_5
+set -euo pipefail
+
+generate=$1
+cpp1=$2
+rust1=$3
+cpp5=$4
+rust5=$5
+
+work=${TEST_TMPDIR:-$(mktemp -d)}
+report=${TEST_UNDECLARED_OUTPUTS_DIR:-$work}/parity.tsv
+printf 'day\tbytes\tengine\tanswer\tms\tMB/s\n' > "$report"
+failures=0
+
+# run PATTERN COMMAND...: sets answer to the number ending the last output
+# line matching PATTERN, and ms to the wall time
+run() {
+    local pattern=$1
+    shift
+    local start end output
+    start=$(date +%s%N)
+    output=$("$@" 2>/dev/null) || { echo "FAILED: $*" >&2; failures=$((failures + 1)); }
+    end=$(date +%s%N)
+    ms=$(( (end - start) / 1000000 ))
+    answer=$(printf '%s\n' "$output" | grep -E "$pattern" | tail -1 | grep -oE -- '-?[0-9]+$' || true)
+}
+
+record() {
+    local day=$1 bytes=$2 engine=$3
+    local rate
+    rate=$(awk -v b="$bytes" -v ms="$ms" 'BEGIN { printf "%.1f", (ms > 0 ? b / 1e3 / ms : 0) }')
+    printf '%s\t%s\t%s\t%s\t%s\t%s\n' "$day" "$bytes" "$engine" "$answer" "$ms" "$rate" >> "$report"
+}
+
+# compare DAY BYTES FORMAT CPP_PATTERN RUST_PATTERN RUST_ARGS...: the input
+# path is appended to the Rust arguments
+compare() {
+    local day=$1 bytes=$2 format=$3 cpp_pattern=$4 rust_pattern=$5
+    shift 5
+    local input="$work/day${day}_${bytes}.txt"
+    "$generate" --format="$format" --bytes="$bytes" --output="$input"
+    local size
+    size=$(wc -c < "$input")
+
+    local cpp_binary rust_binary
+    if [ "$day" = 1 ]; then cpp_binary=$cpp1; rust_binary=$rust1; else cpp_binary=$cpp5; rust_binary=$rust5; fi
+
+    run "$cpp_pattern" "$cpp_binary" --filename="$input"
+    local cpp_answer=$answer
+    record "$day" "$size" cpp
+    run "$rust_pattern" "$rust_binary" "$@" "$input"
+    local rust_answer=$answer
+    record "$day" "$size" rust
+
+    if [ -z "$cpp_answer" ] || [ "$cpp_answer" != "$rust_answer" ]; then
+        echo "MISMATCH day $day, $size bytes: C++ '$cpp_answer', Rust '$rust_answer'" >&2
+        failures=$((failures + 1))
+    fi
+}
+
+# Day 1 in Rust is quadratic in the number of lines, so its inputs stay small
+for bytes in 16384 131072; do
+    compare 1 "$bytes" two_columns '^Sum of counts:' '^Similarity:' --filename
+done
+for bytes in 16384 262144; do
+    compare 5 "$bytes" rules '^Total sum of center elements:' '^Total sum of center elements:'
+done
+
+column -t -s $'\t' "$report" 2>/dev/null || cat "$report"
+if [ "$failures" -ne 0 ]; then
+    echo "$failures parity failure(s)" >&2
+    exit 1
+fi
@@ -0,0 +1,21 @@
+#include "table/allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+// Kept out of the tests' own translation unit, where GCC would see these
+// definitions and warn that free() is paired with new
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+void* operator new(size_t size) {
+    allocationCount++;
+    allocatedBytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
@@ -0,0 +1,12 @@
+#ifndef allocation_counter_h
+#define allocation_counter_h
+
+#include <atomic>
+#include <cstddef>
+
+// Every heap allocation made by a binary that links allocation_counter.cc,
+// and their bytes. Only for tests: it replaces the global operator new.
+extern std::atomic<size_t> allocationCount;
+extern std::atomic<size_t> allocatedBytes;
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef columnar_table_h
+#define columnar_table_h
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "table/table.h"
+
+// Structure-of-arrays counterpart of Table for rectangular inputs: each
+// column is stored contiguously, and the parser appends every token straight
+// to its column, so column scans, sorts and reductions never touch rows.
+template <typename T>
+class ColumnarTable
+{
+public:
+  ColumnarTable() = default;
+
+  // Parses whitespace (or delimiter) separated rows. The first non-empty
+  // line fixes the number of columns; a row with a different number of
+  // values throws std::invalid_argument.
+  explicit ColumnarTable(std::string_view input, char delimiter = ' ') {
+    size_t rowCount = 0;
+    forEachLine(input, [&](std::string_view line) {
+      size_t column = 0;
+      forEachToken(line, delimiter, [&](std::string_view token) {
+        if (rowCount == 0) {
+          columns.emplace_back();
+        }
+        if (column < columns.size()) {
+          columns[column].push_back(parseValue<T>(token));
+        }
+        column++;
+      });
+      if (column != columns.size()) {
+        throw std::invalid_argument("ColumnarTable: row " + std::to_string(rowCount) + " has " +
+                                    std::to_string(column) + " columns, expected " +
+                                    std::to_string(columns.size()));
+      }
+      rowCount++;
+    });
+    rows = rowCount;
+  }
+
+  // Number of rows
+  size_t size() const
+  {
+    return rows;
+  }
+
+  size_t columnCount() const
+  {
+    return columns.size();
+  }
+
+  // Contiguous view of column c
+  Row<T> column(size_t c) const
+  {
+    return Row<T>(columns.at(c));
+  }
+
+  // Moves column c out of the table, e.g. to sort it in place. The column
+  // is left empty.
+  std::vector<T> releaseColumn(size_t c)
+  {
+    return std::move(columns.at(c));
+  }
+
+private:
+  std::vector<std::vector<T>> columns;
+  size_t rows = 0;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef cpu_features_h
+#define cpu_features_h
+
+// Runtime CPU feature checks used to pick between SIMD kernels. SSE2 is part
+// of the x86-64 baseline, so only AVX2 needs a runtime check.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TABLE_HAVE_X86_SIMD 1
+#else
+#define TABLE_HAVE_X86_SIMD 0
+#endif
+
+inline bool cpuHasAvx2() {
+#if TABLE_HAVE_X86_SIMD
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+#else
+    return false;
+#endif
+}
+
+#endif
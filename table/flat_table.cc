@@ -0,0 +1,126 @@
+#include "table/flat_table.h"
+
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+static_assert(sizeof(int) == sizeof(int32_t), "Table<int> and FlatTableI32 must share a layout");
+
+// The release callback is called through a C function pointer
+extern "C" {
+static void deleteTable(void* owner)
+{
+  delete static_cast<Table<int32_t>*>(owner);
+}
+}
+
+namespace {
+
+// Empty and released tables still have their one offset, and nothing to free
+const size_t kEmptyOffsets[1] = {0};
+const FlatTableI32 kEmpty = {nullptr, kEmptyOffsets, 0, nullptr, nullptr};
+
+// The same set as Rust's char::is_ascii_whitespace, so both parsers split
+// alike; note that '\v' is not in it
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+}
+
+std::string_view trim(std::string_view text)
+{
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// A whole token as an int32, with an optional leading '+', as Rust's
+// str::parse::<i32> reads it. Table's parser stops at the first non-digit;
+// this one fails instead.
+bool parseToken(std::string_view token, std::vector<int32_t>& values)
+{
+  if (token.size() > 1 && token[0] == '+' && token[1] != '-') {
+    token.remove_prefix(1);
+  }
+  int32_t value = 0;
+  auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+  if (ec != std::errc() || ptr != token.data() + token.size()) {
+    return false;
+  }
+  values.push_back(value);
+  return true;
+}
+
+bool parseLine(std::string_view line, char delimiter, std::vector<int32_t>& values)
+{
+  while (!line.empty()) {
+    size_t end = 0;
+    if (delimiter == ' ') {
+      line = trim(line);
+      while (end < line.size() && !isSpace(line[end])) {
+        end++;
+      }
+    } else {
+      end = std::min(line.find(delimiter), line.size());
+    }
+    std::string_view token = trim(line.substr(0, end));
+    if (!token.empty() && !parseToken(token, values)) {
+      return false;
+    }
+    line.remove_prefix(std::min(end + 1, line.size()));
+  }
+  return true;
+}
+
+}  // namespace
+
+FlatTableI32 toFlatTable(Table<int32_t>&& table)
+{
+  Table<int32_t>* owner = new Table<int32_t>(std::move(table));
+  return FlatTableI32{owner->valueData(), owner->offsetData(), owner->size(), owner, deleteTable};
+}
+
+extern "C" void flat_table_i32_release(FlatTableI32* table)
+{
+  if (table == nullptr) {
+    return;
+  }
+  if (table->release != nullptr) {
+    table->release(table->owner);
+  }
+  *table = kEmpty;
+}
+
+extern "C" int flat_table_i32_parse_cpp(const char* text, size_t length, char delimiter, FlatTableI32* out)
+{
+  if (out == nullptr) {
+    return 1;
+  }
+  *out = kEmpty;
+  if (static_cast<unsigned char>(delimiter) > 0x7f || (text == nullptr && length > 0)) {
+    return 1;
+  }
+  std::vector<int32_t> values;
+  std::vector<size_t> offsets(1, 0);
+  std::string_view input(text, length);
+  while (!input.empty()) {
+    size_t newline = std::min(input.find('\n'), input.size());
+    std::string_view line = input.substr(0, newline);
+    input.remove_prefix(std::min(newline + 1, input.size()));
+    if (trim(line).empty()) {
+      continue;
+    }
+    if (!parseLine(line, delimiter, values)) {
+      return 1;
+    }
+    offsets.push_back(values.size());
+  }
+  *out = toFlatTable(Table<int32_t>(std::move(values), std::move(offsets)));
+  return 0;
+}
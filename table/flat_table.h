@@ -0,0 +1,89 @@
+#ifndef flat_table_h
+#define flat_table_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A table of int32 values shared between the C++ (table.h) and Rust
+// (table.rs) parsers without copying. Every value sits in one buffer, row
+// after row; row r is values[row_offsets[r]] up to values[row_offsets[r + 1]],
+// so row_offsets has row_count + 1 entries starting at 0. The producer owns
+// the buffers: release(owner) frees them and may be null for a borrowed
+// table. The same layout is FlatTable in table.rs.
+typedef struct FlatTableI32 {
+  const int32_t* values;
+  const size_t* row_offsets;
+  size_t row_count;
+  void* owner;
+  void (*release)(void* owner);
+} FlatTableI32;
+
+// Frees the table's buffers through its release callback, once, and clears
+// the table. A null table is ignored.
+void flat_table_i32_release(FlatTableI32* table);
+
+// Parse length bytes of text into *out, one row per line that is not all
+// whitespace. Whitespace means ASCII space, '\t', '\n', '\f' and '\r'. A ' '
+// delimiter splits on runs of whitespace; any other (ASCII) delimiter splits
+// on itself, trims whitespace around each value and skips empty ones. Every
+// value must be a whole int32 with an optional sign. Return 0 on success;
+// otherwise return nonzero and leave *out an empty table with nothing to
+// release. A null out returns nonzero. Both parsers give the same table for
+// the same bytes.
+//
+// The C++ one is deliberately stricter than table.h's bulk parser, which
+// stops a value at its first non-digit; C++ code that parses with Table
+// hands the result over with toFlatTable instead.
+int flat_table_i32_parse_cpp(const char* text, size_t length, char delimiter, FlatTableI32* out);
+int flat_table_i32_parse_rust(const char* text, size_t length, char delimiter, FlatTableI32* out);
+
+// Sum of every value, computed in Rust over the caller's buffers
+int64_t flat_table_i32_sum_rust(const FlatTableI32* table);
+
+#ifdef __cplusplus
+}  // extern "C"
+
+#include "table/table.h"
+
+// How table.h's parser hands its output across the C interface, e.g. for
+// Rust to compute over. The Table moves to the heap and the FlatTableI32
+// points into its buffers until released.
+FlatTableI32 toFlatTable(Table<int32_t>&& table);
+
+// Read-only view of a FlatTableI32 with the same row interface as Table.
+// Holds a copy of the struct but does not take ownership of the buffers.
+class FlatTableView
+{
+public:
+  explicit FlatTableView(const FlatTableI32& table) : table(table) {}
+
+  Row<int32_t> operator[](size_t r) const
+  {
+    return Row<int32_t>(table.values + table.row_offsets[r], table.row_offsets[r + 1] - table.row_offsets[r]);
+  }
+
+  size_t size() const
+  {
+    return table.row_count;
+  }
+
+  ConstRowItr<int32_t> begin() const
+  {
+    return ConstRowItr<int32_t>(table.values, table.row_offsets);
+  }
+
+  ConstRowItr<int32_t> end() const
+  {
+    return ConstRowItr<int32_t>(table.values, table.row_offsets + table.row_count);
+  }
+
+private:
+  FlatTableI32 table;
+};
+#endif
+
+#endif
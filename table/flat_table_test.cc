@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "table/flat_table.h"
+
+static std::vector<std::vector<int32_t>> rowsOf(const FlatTableI32& table) {
+    std::vector<std::vector<int32_t>> rows;
+    for (const Row<int32_t>& row : FlatTableView(table)) {
+        rows.emplace_back(row.begin(), row.end());
+    }
+    return rows;
+}
+
+TEST(FlatTable, CppProducerKeepsTheTableBuffers) {
+    Table<int32_t> table(std::string_view("1 2 3\n4\n\n5 6\n"));
+    const int32_t* values = table.valueData();
+    FlatTableI32 flat = toFlatTable(std::move(table));
+    // Moved, not copied
+    EXPECT_EQ(flat.values, values);
+    EXPECT_EQ(flat.row_count, 3u);
+    EXPECT_EQ(flat.row_offsets[3], 6u);
+    FlatTableView view(flat);
+    EXPECT_EQ(view[1].size(), 1u);
+    EXPECT_EQ(view[2][1], 6);
+    EXPECT_EQ(rowsOf(flat), (std::vector<std::vector<int32_t>>{{1, 2, 3}, {4}, {5, 6}}));
+    flat_table_i32_release(&flat);
+    EXPECT_EQ(flat.row_count, 0u);
+    EXPECT_EQ(flat.release, nullptr);
+    // Releasing twice is harmless
+    flat_table_i32_release(&flat);
+}
+
+TEST(FlatTable, BothParsersAgree) {
+    struct Case {
+        std::string input;
+        char delimiter;
+        std::vector<std::vector<int32_t>> rows;
+    };
+    const Case cases[] = {
+        {"7 6 4 2 1\n1 2 7 8 9\n9   7 6 2 1\n", ' ', {{7, 6, 4, 2, 1}, {1, 2, 7, 8, 9}, {9, 7, 6, 2, 1}}},
+        {"75,47,61,53,29\r\n97,61,53\r\n", ',', {{75, 47, 61, 53, 29}, {97, 61, 53}}},
+        {"", ' ', {}},
+        // Tabs separate values like spaces
+        {"1\t2\n", ' ', {{1, 2}}},
+        // Whitespace-only lines are not rows
+        {" \n1\n\t\r\n", ' ', {{1}}},
+        {"1, 2,,3\n \n+4 ,-5\n", ',', {{1, 2, 3}, {4, -5}}},
+        {"-2147483648 +2147483647", ' ', {{-2147483647 - 1, 2147483647}}},
+    };
+    for (const Case& c : cases) {
+        FlatTableI32 fromCpp;
+        FlatTableI32 fromRust;
+        ASSERT_EQ(flat_table_i32_parse_cpp(c.input.data(), c.input.size(), c.delimiter, &fromCpp), 0) << c.input;
+        ASSERT_EQ(flat_table_i32_parse_rust(c.input.data(), c.input.size(), c.delimiter, &fromRust), 0) << c.input;
+        EXPECT_EQ(rowsOf(fromCpp), c.rows) << c.input;
+        EXPECT_EQ(rowsOf(fromRust), c.rows) << c.input;
+        flat_table_i32_release(&fromCpp);
+        flat_table_i32_release(&fromRust);
+    }
+}
+
+TEST(FlatTable, BothParsersRejectPartialValues) {
+    const std::string inputs[] = {"3 4x\n", "1 2\n3 x\n", "2147483648\n", "+-5\n", "+\n", "1;2\n", "1\v2\n"};
+    for (const std::string& input : inputs) {
+        FlatTableI32 fromCpp;
+        FlatTableI32 fromRust;
+        EXPECT_NE(flat_table_i32_parse_cpp(input.data(), input.size(), ' ', &fromCpp), 0) << input;
+        EXPECT_NE(flat_table_i32_parse_rust(input.data(), input.size(), ' ', &fromRust), 0) << input;
+        // Left empty, with nothing to release
+        for (const FlatTableI32* flat : {&fromCpp, &fromRust}) {
+            EXPECT_EQ(flat->row_count, 0u);
+            EXPECT_EQ(flat->row_offsets[0], 0u);
+            EXPECT_EQ(flat->release, nullptr);
+            EXPECT_EQ(flat_table_i32_sum_rust(flat), 0);
+        }
+    }
+
+    // Null pointers are refused alike
+    const char text[] = "1 2\n";
+    EXPECT_NE(flat_table_i32_parse_cpp(text, 4, ' ', nullptr), 0);
+    EXPECT_NE(flat_table_i32_parse_rust(text, 4, ' ', nullptr), 0);
+    FlatTableI32 fromCpp;
+    FlatTableI32 fromRust;
+    EXPECT_NE(flat_table_i32_parse_cpp(nullptr, 4, ' ', &fromCpp), 0);
+    EXPECT_NE(flat_table_i32_parse_rust(nullptr, 4, ' ', &fromRust), 0);
+    EXPECT_EQ(fromCpp.row_count, 0u);
+    EXPECT_EQ(fromRust.row_count, 0u);
+    EXPECT_EQ(fromCpp.release, nullptr);
+    EXPECT_EQ(fromRust.release, nullptr);
+    flat_table_i32_release(nullptr);
+}
+
+TEST(FlatTable, ViewOfATemporaryStruct) {
+    Table<int32_t> table(std::string_view("1 2\n3\n"));
+    FlatTableView view(FlatTableI32{table.valueData(), table.offsetData(), table.size(), nullptr, nullptr});
+    ASSERT_EQ(view.size(), 2u);
+    EXPECT_EQ(view[1][0], 3);
+}
+
+TEST(FlatTable, RustComputesOverCppBuffers) {
+    const std::string input = "2147483647 2147483647\n-5 3\n";
+    FlatTableI32 flat;
+    ASSERT_EQ(flat_table_i32_parse_cpp(input.data(), input.size(), ' ', &flat), 0);
+    // Summed in 64 bits on the Rust side
+    EXPECT_EQ(flat_table_i32_sum_rust(&flat), 2LL * 2147483647 - 2);
+
+    // A table the caller still owns can be lent without a release callback
+    Table<int32_t> table(std::string_view("1 2\n3\n"));
+    FlatTableI32 borrowed = {table.valueData(), table.offsetData(), table.size(), nullptr, nullptr};
+    EXPECT_EQ(flat_table_i32_sum_rust(&borrowed), 6);
+    flat_table_i32_release(&flat);
+}
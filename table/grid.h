@@ -0,0 +1,151 @@
+#ifndef grid_h
+#define grid_h
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "table/table.h"
+
+// A relative cell position, row then column
+struct Step
+{
+  int row;
+  int col;
+};
+
+// Common stencils, usable as compile-time constants
+namespace stencil {
+inline constexpr std::array<Step, 4> kOrthogonal = {{{-1, 0}, {0, -1}, {0, 1}, {1, 0}}};
+inline constexpr std::array<Step, 4> kDiagonal = {{{-1, -1}, {-1, 1}, {1, -1}, {1, 1}}};
+inline constexpr std::array<Step, 8> kNeighbours = {
+    {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}}};
+}  // namespace stencil
+
+// Dense 2D grid stored row-major in one buffer with a fixed stride. The real
+// cells are surrounded by `halo` rows and columns of a sentinel value, plus
+// `slack` extra sentinel columns on the right for vector loads that run past
+// the last column, so a stencil of radius up to `halo` can read any
+// neighbour without bounds checks. Rows and columns outside the grid are
+// addressed with negative or past-the-end indices.
+template <typename T>
+class Grid
+{
+public:
+  Grid() = default;
+
+  Grid(size_t height, size_t width, const T& sentinel, size_t halo = 1, size_t slack = 0)
+      : rows(height), cols(width), pad(halo), gridStride(width + 2 * halo + slack),
+        cells(gridStride * (height + 2 * halo), sentinel)
+  {
+  }
+
+  // Copies a table into the grid. The width is that of the longest row;
+  // shorter rows are filled out with the sentinel.
+  Grid(const Table<T>& table, const T& sentinel, size_t halo = 1, size_t slack = 0)
+      : Grid(table.size(), widest(table), sentinel, halo, slack)
+  {
+    for (size_t r = 0; r < rows; r++) {
+      Row<T> row = table[r];
+      std::copy(row.begin(), row.end(), rowData(r));
+    }
+  }
+
+  size_t height() const
+  {
+    return rows;
+  }
+
+  size_t width() const
+  {
+    return cols;
+  }
+
+  // Distance in elements between vertically adjacent cells
+  size_t stride() const
+  {
+    return gridStride;
+  }
+
+  size_t halo() const
+  {
+    return pad;
+  }
+
+  // Cell (r, 0); r may be anywhere in [-halo, height + halo)
+  T* rowData(ptrdiff_t r)
+  {
+    return cells.data() + (r + static_cast<ptrdiff_t>(pad)) * static_cast<ptrdiff_t>(gridStride) + pad;
+  }
+
+  const T* rowData(ptrdiff_t r) const
+  {
+    return cells.data() + (r + static_cast<ptrdiff_t>(pad)) * static_cast<ptrdiff_t>(gridStride) + pad;
+  }
+
+  // The real cells of row r
+  Row<T> row(size_t r) const
+  {
+    return Row<T>(rowData(r), cols);
+  }
+
+  T& operator()(ptrdiff_t r, ptrdiff_t c)
+  {
+    return rowData(r)[c];
+  }
+
+  const T& operator()(ptrdiff_t r, ptrdiff_t c) const
+  {
+    return rowData(r)[c];
+  }
+
+  // Pointer offset of a neighbour at a step known at compile time
+  template <int RowStep, int ColStep>
+  ptrdiff_t offset() const
+  {
+    static_assert(RowStep != 0 || ColStep != 0, "a stencil step must move");
+    return RowStep * static_cast<ptrdiff_t>(gridStride) + ColStep;
+  }
+
+  ptrdiff_t offset(Step step) const
+  {
+    return step.row * static_cast<ptrdiff_t>(gridStride) + step.col;
+  }
+
+  // Pointer offsets for every step of a stencil, computed once per grid
+  template <size_t N>
+  std::array<ptrdiff_t, N> offsets(const std::array<Step, N>& steps) const
+  {
+    std::array<ptrdiff_t, N> result{};
+    for (size_t i = 0; i < N; i++) {
+      result[i] = offset(steps[i]);
+    }
+    return result;
+  }
+
+  // Neighbour of the cell at `cell` (a pointer into this grid)
+  template <int RowStep, int ColStep>
+  const T& neighbour(const T* cell) const
+  {
+    return cell[offset<RowStep, ColStep>()];
+  }
+
+private:
+  static size_t widest(const Table<T>& table)
+  {
+    size_t width = 0;
+    for (const Row<T>& row : table) {
+      width = std::max(width, row.size());
+    }
+    return width;
+  }
+
+  size_t rows = 0;
+  size_t cols = 0;
+  size_t pad = 0;
+  size_t gridStride = 0;
+  std::vector<T> cells;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef grid_scan_h
+#define grid_scan_h
+
+#include <algorithm>
+#include <cstddef>
+#include <unistd.h>
+
+#include "exec/pool.h"
+#include "table/grid.h"
+
+// Per-core L2 size, or 256 KiB when the system does not report it
+inline size_t l2CacheBytes()
+{
+  static const size_t bytes = [] {
+    long reported = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    reported = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    return reported > 0 ? static_cast<size_t>(reported) : size_t(256) << 10;
+  }();
+  return bytes;
+}
+
+// Rows per band for a scan over `rows` rows of `rowBytes` each, where the
+// kernel also reads `halo` rows above and below its band. A band and its
+// halo take at most half of cacheBytes, leaving the rest for whatever else
+// the kernel touches, and the rows are split at least `threads` ways so
+// every thread gets work.
+inline size_t bandRows(size_t rows, size_t rowBytes, size_t halo, unsigned threads, size_t cacheBytes)
+{
+  size_t fit = cacheBytes / 2 / std::max<size_t>(rowBytes, 1);
+  fit = fit > 2 * halo ? fit - 2 * halo : 1;
+  size_t share = (rows + std::max(threads, 1u) - 1) / std::max(threads, 1u);
+  return std::max<size_t>(1, std::min(fit, share));
+}
+
+// Splits [0, rows) into cache-sized bands, runs kernel(rowBegin, rowEnd) on
+// each band in the pool and adds up the results. The kernel may read up to
+// `halo` rows either side of its band; the bands only split the work, the
+// rows themselves stay shared, so any row-range kernel over a Table or a
+// Grid can be used as is.
+template <typename Kernel>
+long long scanRowBands(ThreadPool& pool, size_t rows, size_t rowBytes, size_t halo, Kernel kernel,
+                       size_t cacheBytes = l2CacheBytes())
+{
+  size_t grain = bandRows(rows, rowBytes, halo, pool.size(), cacheBytes);
+  return pool.parallel_reduce(
+      0, rows, grain, 0LL,
+      [&](size_t rowBegin, size_t rowEnd) { return static_cast<long long>(kernel(rowBegin, rowEnd)); },
+      [](long long a, long long b) { return a + b; });
+}
+
+// Runs kernel(grid, rowBegin, rowEnd) over row bands of the grid. The grid's
+// sentinel halo covers the rows above the first band and below the last.
+template <typename T, typename Kernel>
+long long scanGridBands(ThreadPool& pool, const Grid<T>& grid, Kernel kernel, size_t cacheBytes = l2CacheBytes())
+{
+  return scanRowBands(
+      pool, grid.height(), grid.stride() * sizeof(T), grid.halo(),
+      [&](size_t rowBegin, size_t rowEnd) { return kernel(grid, rowBegin, rowEnd); }, cacheBytes);
+}
+
+#endif
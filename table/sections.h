@@ -0,0 +1,79 @@
+#ifndef sections_h
+#define sections_h
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "table/table.h"
+
+// Views of the blocks of input separated by blank lines. A line holding only
+// "\r" counts as blank, runs of blank lines separate just once, and leading
+// or trailing blank lines produce no empty sections. Nothing is copied.
+inline std::vector<std::string_view> splitSections(std::string_view input)
+{
+  std::vector<std::string_view> sections;
+  size_t sectionBegin = std::string_view::npos;
+  size_t lineBegin = 0;
+  while (lineBegin < input.size()) {
+    size_t newline = input.find('\n', lineBegin);
+    size_t lineEnd = newline == std::string_view::npos ? input.size() : newline;
+    size_t next = newline == std::string_view::npos ? input.size() : newline + 1;
+    bool blank = lineEnd == lineBegin || (lineEnd == lineBegin + 1 && input[lineBegin] == '\r');
+    if (blank) {
+      if (sectionBegin != std::string_view::npos) {
+        sections.push_back(input.substr(sectionBegin, lineBegin - sectionBegin));
+        sectionBegin = std::string_view::npos;
+      }
+    } else if (sectionBegin == std::string_view::npos) {
+      sectionBegin = lineBegin;
+    }
+    lineBegin = next;
+  }
+  if (sectionBegin != std::string_view::npos) {
+    sections.push_back(input.substr(sectionBegin));
+  }
+  return sections;
+}
+
+// Layout of one section: its element type and the delimiter between values
+template <typename T>
+struct Section
+{
+  char delimiter = ' ';
+};
+
+namespace sections_internal {
+template <typename... T, size_t... I>
+std::tuple<Table<T>...> parse(const std::vector<std::string_view>& sections,
+                              const std::tuple<Section<T>...>& layouts, std::index_sequence<I...>)
+{
+  return std::tuple<Table<T>...>(Table<T>(sections[I], std::get<I>(layouts).delimiter)...);
+}
+}  // namespace sections_internal
+
+// Parses blank-line separated sections, each with its own type and
+// delimiter, straight from the input into flat Tables:
+//
+//   auto [rules, updates] = parseSections(input, Section<int>{'|'}, Section<int>{','});
+//
+// Sections missing from the end of the input come back as empty tables;
+// more sections than layouts throw std::invalid_argument.
+template <typename... T>
+std::tuple<Table<T>...> parseSections(std::string_view input, Section<T>... layouts)
+{
+  std::vector<std::string_view> sections = splitSections(input);
+  if (sections.size() > sizeof...(T)) {
+    throw std::invalid_argument("parseSections: found " + std::to_string(sections.size()) +
+                                " sections, expected at most " + std::to_string(sizeof...(T)));
+  }
+  sections.resize(sizeof...(T));
+  return sections_internal::parse(sections, std::tuple<Section<T>...>(layouts...),
+                                 std::index_sequence_for<T...>());
+}
+
+#endif
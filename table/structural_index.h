@@ -0,0 +1,108 @@
+#ifndef structural_index_h
+#define structural_index_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "table/cpu_features.h"
+
+#if TABLE_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Structural indexing in the style of simdjson: the input is classified 64
+// bytes at a time into a bitmask of newline/delimiter positions, and the set
+// bits are then expanded into a list of offsets. Parsers walk that list
+// instead of searching the text byte by byte.
+
+// Appends base + i for every set bit i of mask
+inline void appendMaskPositions(uint64_t mask, uint32_t base, std::vector<uint32_t>& out) {
+    if (mask == 0) {
+        return;
+    }
+    size_t start = out.size();
+    out.resize(start + __builtin_popcountll(mask));
+    uint32_t* dst = out.data() + start;
+    while (mask != 0) {
+        *dst++ = base + static_cast<uint32_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+}
+
+inline uint64_t structuralMaskScalar(const char* block, size_t size, char delimiter) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (block[i] == '\n' || block[i] == delimiter) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    return mask;
+}
+
+#if TABLE_HAVE_X86_SIMD
+inline uint64_t structuralMaskSse2(const char* block, char delimiter) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i delim = _mm_set1_epi8(delimiter);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, delim));
+        mask |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(hits))) << (16 * i);
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+inline uint64_t structuralMaskAvx2(const char* block, char delimiter) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i delim = _mm256_set1_epi8(delimiter);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    __m256i hitsLo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, newline), _mm256_cmpeq_epi8(lo, delim));
+    __m256i hitsHi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, newline), _mm256_cmpeq_epi8(hi, delim));
+    return uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hitsLo))) |
+           uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hitsHi))) << 32;
+}
+
+__attribute__((target("avx2")))
+inline void buildStructuralIndexAvx2(const char* data, size_t size, char delimiter, std::vector<uint32_t>& out) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        appendMaskPositions(structuralMaskAvx2(data + i, delimiter), static_cast<uint32_t>(i), out);
+    }
+    appendMaskPositions(structuralMaskScalar(data + i, size - i, delimiter), static_cast<uint32_t>(i), out);
+}
+
+inline void buildStructuralIndexSse2(const char* data, size_t size, char delimiter, std::vector<uint32_t>& out) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        appendMaskPositions(structuralMaskSse2(data + i, delimiter), static_cast<uint32_t>(i), out);
+    }
+    appendMaskPositions(structuralMaskScalar(data + i, size - i, delimiter), static_cast<uint32_t>(i), out);
+}
+#endif
+
+inline void buildStructuralIndexScalar(const char* data, size_t size, char delimiter, std::vector<uint32_t>& out) {
+    for (size_t i = 0; i < size; i += 64) {
+        size_t block = size - i < 64 ? size - i : 64;
+        appendMaskPositions(structuralMaskScalar(data + i, block, delimiter), static_cast<uint32_t>(i), out);
+    }
+}
+
+// Appends the offset of every '\n' and delimiter in data[0, size) to out.
+// Offsets are 32 bit, so callers index inputs in windows below 4 GiB.
+inline void buildStructuralIndex(const char* data, size_t size, char delimiter, std::vector<uint32_t>& out) {
+#if TABLE_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        buildStructuralIndexAvx2(data, size, delimiter, out);
+    } else {
+        buildStructuralIndexSse2(data, size, delimiter, out);
+    }
+#else
+    buildStructuralIndexScalar(data, size, delimiter, out);
+#endif
+}
+
+#endif
@@ -1,68 +1,134 @@
 #ifndef table_h
 #define table_h
 
+#include <algorithm>
+#include <charconv>
 #include <istream>
+#include <stdexcept>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 #include <iostream>
+#include <iterator>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <type_traits>
+
+#include "table/structural_index.h"
 
 // Forward declarations
 template <typename T>
 class Row;
 
-// Parsing utilities
+// Parsing utilities. Values are parsed in place from string_views with
+// std::from_chars, so parsing a number never allocates.
 template <typename T>
-T parseValue(const std::string& str);
+T parseValue(std::string_view str);
+
+// Drops the leading whitespace and '+' sign that std::stoi/stod accept but
+// std::from_chars does not
+inline std::string_view trimNumber(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && (str[start] == ' ' || (str[start] >= '\t' && str[start] <= '\r'))) {
+        start++;
+    }
+    if (start + 1 < str.size() && str[start] == '+' && str[start + 1] != '-') {
+        start++;
+    }
+    return str.substr(start);
+}
+
+template <typename T>
+T parseNumber(std::string_view str) {
+    str = trimNumber(str);
+    T value{};
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec == std::errc::invalid_argument) {
+        throw std::invalid_argument("parseValue: not a number");
+    }
+    if (ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("parseValue: number out of range");
+    }
+    return value;
+}
 
 // Specialization for int
 template <>
-inline int parseValue<int>(const std::string& str) {
-    return std::stoi(str);
+inline int parseValue<int>(std::string_view str) {
+    return parseNumber<int>(str);
 }
 
 // Specialization for double
 template <>
-inline double parseValue<double>(const std::string& str) {
-    return std::stod(str);
+inline double parseValue<double>(std::string_view str) {
+    return parseNumber<double>(str);
 }
 
 // Specialization for string
 template <>
-inline std::string parseValue<std::string>(const std::string& str) {
-    return str;
+inline std::string parseValue<std::string>(std::string_view str) {
+    return std::string(str);
 }
 
 // Specialization for char
 template <>
-inline char parseValue<char>(const std::string& str) {
+inline char parseValue<char>(std::string_view str) {
     return str.empty() ? '\0' : str[0];
 }
 
-template <typename T>
-std::vector<T> parseRow(const std::string& rowData, char delimiter = ' ') {
-    std::vector<T> result;
-    std::stringstream ss(rowData);
-    std::string token;
-    
-    while (std::getline(ss, token, delimiter)) {
-        if (!token.empty()) {
-            result.push_back(parseValue<T>(token));
+// Calls f with every non-empty token of rowData, without copying
+template <typename F>
+void forEachToken(std::string_view rowData, char delimiter, F&& f) {
+    size_t start = 0;
+    while (start < rowData.size()) {
+        size_t end = rowData.find(delimiter, start);
+        if (end == std::string_view::npos) {
+            end = rowData.size();
         }
+        if (end > start) {
+            f(rowData.substr(start, end - start));
+        }
+        start = end + 1;
     }
-    
-    return result;
+}
+
+// Calls f with every non-empty line of input, without the trailing '\n'
+template <typename F>
+void forEachLine(std::string_view input, F&& f) {
+    while (!input.empty()) {
+        size_t newline = input.find('\n');
+        std::string_view line = input.substr(0, newline);
+        input.remove_prefix(newline == std::string_view::npos ? input.size() : newline + 1);
+        if (!line.empty()) {
+            f(line);
+        }
+    }
+}
+
+// Appends the parsed values of rowData to out. Once out has grown to fit a
+// row this does not allocate for numeric types.
+template <typename T>
+void parseRowInto(std::string_view rowData, char delimiter, std::vector<T>& out) {
+    forEachToken(rowData, delimiter, [&out](std::string_view token) {
+        out.push_back(parseValue<T>(token));
+    });
 }
 
 // Specialization for char to parse each character individually (no delimiter)
 template <>
-inline std::vector<char> parseRow<char>(const std::string& rowData, char delimiter) {
-    std::vector<char> result;
+inline void parseRowInto<char>(std::string_view rowData, [[maybe_unused]] char delimiter, std::vector<char>& out) {
     for (char c : rowData) {
         if (c != '\r' && c != '\n') {  // Skip line ending characters
-            result.push_back(c);
+            out.push_back(c);
         }
     }
+}
+
+template <typename T>
+std::vector<T> parseRow(std::string_view rowData, char delimiter = ' ') {
+    std::vector<T> result;
+    parseRowInto(rowData, delimiter, result);
     return result;
 }
 
@@ -80,83 +146,353 @@ std::vector<std::vector<T>> parseTable(std::istream& input, char delimiter = ' '
     return result;
 }
 
+// Same as above, but reads from an in-memory (e.g. memory mapped) buffer
+template <typename T>
+std::vector<std::vector<T>> parseTable(std::string_view input, char delimiter = ' ') {
+    std::vector<std::vector<T>> result;
+    forEachLine(input, [&](std::string_view line) {
+        result.push_back(parseRow<T>(line, delimiter));
+    });
+    return result;
+}
+
+// Bulk parser behind Table(std::string_view). The input is walked in windows
+// cut at line boundaries; each window gets a structural index of its newline
+// and delimiter offsets, and rows are parsed by walking that index. Parsed
+// values are appended to values, and offsets gets one end offset per row.
+template <typename T>
+void parseIndexedInto(std::string_view input, char delimiter, std::vector<T>& values, std::vector<size_t>& offsets) {
+    constexpr size_t kWindowSize = 1 << 18;
+    constexpr bool kCharRows = std::is_same<T, char>::value;
+    // Char rows keep every byte, so only newlines are structural
+    const char structural = kCharRows ? '\n' : delimiter;
+    std::vector<uint32_t> index;
+    if (kCharRows) {
+        // Char rows never hold more values than the input has bytes
+        values.reserve(values.size() + input.size());
+    }
+
+    size_t pos = 0;
+    while (pos < input.size()) {
+        const char* window = input.data() + pos;
+        size_t windowSize = kWindowSize;
+        size_t length = 0;
+        size_t indexSize = 0;
+        while (true) {
+            length = std::min(windowSize, input.size() - pos);
+            index.clear();
+            buildStructuralIndex(window, length, structural, index);
+            indexSize = index.size();
+            if (pos + length == input.size()) {
+                break;
+            }
+            // Cut the window after its last newline; lines longer than the
+            // window make it grow until one fits
+            while (indexSize > 0 && window[index[indexSize - 1]] != '\n') {
+                indexSize--;
+            }
+            if (indexSize > 0) {
+                length = index[indexSize - 1] + 1;
+                break;
+            }
+            windowSize *= 2;
+        }
+
+        size_t lineStart = 0;
+        size_t tokenStart = 0;
+        auto finishToken = [&](size_t end) {
+            if (!kCharRows && end > tokenStart) {
+                values.push_back(parseValue<T>(std::string_view(window + tokenStart, end - tokenStart)));
+            }
+            tokenStart = end + 1;
+        };
+        auto finishLine = [&](size_t end) {
+            if (end > lineStart) {
+                if (kCharRows) {
+                    const char* first = window + lineStart;
+                    const char* last = window + end;
+                    if (std::memchr(first, '\r', end - lineStart) == nullptr) {
+                        values.insert(values.end(), first, last);
+                    } else {
+                        parseRowInto(std::string_view(first, end - lineStart), delimiter, values);
+                    }
+                }
+                offsets.push_back(values.size());
+            }
+            lineStart = end + 1;
+        };
+
+        for (size_t i = 0; i < indexSize; i++) {
+            size_t p = index[i];
+            finishToken(p);
+            if (window[p] == '\n') {
+                finishLine(p);
+            }
+        }
+        if (lineStart < length) {
+            // Last line of the input has no trailing newline
+            finishToken(length);
+            finishLine(length);
+        }
+        pos += length;
+    }
+}
+
 // Type aliases
 template <typename T>
-using ConstColItr = typename std::vector<T>::const_iterator;
+using ConstColItr = const T*;
 
 template <typename T>
-using ConstRowItr = typename std::vector<Row<T>>::const_iterator;
+class ConstRowItr;
 
+// A Row is a non-owning view of one line of a Table (or of any contiguous
+// buffer of values). Copying a Row never copies the values it refers to.
 template <typename T>
 class Row
 {
 public:
-  // Refactored constructor using the parsing utility
-  Row(const std::string& rowData) : data(parseRow<T>(rowData)) {}
-  
-  // Alternative constructor from parsed data
-  Row(const std::vector<T>& rowData) : data(rowData) {}
+  Row(const T* first, size_t count) : first(first), count(count) {}
+
+  // View over pre-parsed data; the vector must outlive the Row
+  Row(const std::vector<T>& rowData) : first(rowData.data()), count(rowData.size()) {}
+  // A temporary vector would be gone before the Row is used
+  Row(std::vector<T>&&) = delete;
 
   const T operator[](int c) const
   {
-    return data[c]; 
+    return first[c]; 
   }
 
   size_t size() const
   {
-    return data.size();
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
   }
 
-  ConstColItr<T> begin() const { return data.begin(); }
-  ConstColItr<T> end() const { return data.end(); }
+  const T* data() const { return first; }
+
+  ConstColItr<T> begin() const { return first; }
+  ConstColItr<T> end() const { return first + count; }
 
 private:
-  std::vector<T> data;
+  const T* first;
+  size_t count;
 };
 
+// Random access iterator over the rows of a Table, yielding Row views
+template <typename T>
+class ConstRowItr
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Row<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = Row<T>;
+
+  ConstRowItr() : values(nullptr), offset(nullptr) {}
+  ConstRowItr(const T* values, const size_t* offset) : values(values), offset(offset) {}
+
+  Row<T> operator*() const { return Row<T>(values + offset[0], offset[1] - offset[0]); }
+  Row<T> operator[](difference_type n) const { return *(*this + n); }
+
+  ConstRowItr& operator++() { ++offset; return *this; }
+  ConstRowItr operator++(int) { ConstRowItr temp = *this; ++offset; return temp; }
+  ConstRowItr& operator--() { --offset; return *this; }
+  ConstRowItr operator--(int) { ConstRowItr temp = *this; --offset; return temp; }
+  ConstRowItr& operator+=(difference_type n) { offset += n; return *this; }
+  ConstRowItr& operator-=(difference_type n) { offset -= n; return *this; }
+
+  friend ConstRowItr operator+(ConstRowItr it, difference_type n) { return it += n; }
+  friend ConstRowItr operator+(difference_type n, ConstRowItr it) { return it += n; }
+  friend ConstRowItr operator-(ConstRowItr it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const ConstRowItr& a, const ConstRowItr& b) { return a.offset - b.offset; }
+
+  bool operator==(const ConstRowItr& other) const { return offset == other.offset; }
+  bool operator!=(const ConstRowItr& other) const { return offset != other.offset; }
+  bool operator<(const ConstRowItr& other) const { return offset < other.offset; }
+  bool operator>(const ConstRowItr& other) const { return offset > other.offset; }
+  bool operator<=(const ConstRowItr& other) const { return offset <= other.offset; }
+  bool operator>=(const ConstRowItr& other) const { return offset >= other.offset; }
+
+private:
+  const T* values;
+  const size_t* offset;
+};
+
+// Table stores every value in one contiguous buffer. Row r occupies
+// values[offsets[r], offsets[r + 1]), so a table costs two allocations no
+// matter how many lines it has.
 template <typename T>
 class Table
 {
 public:
+  Table() : offsets(1, 0) {}
+
   // Refactored constructor using the parsing utility
-  Table(std::istream& input) {
+  Table(std::istream& input, char delimiter = ' ') : offsets(1, 0) {
     std::string line;
     while (std::getline(input, line)) {
       if (!line.empty()) {
-        data.emplace_back(line);
+        parseRowInto(line, delimiter, values);
+        offsets.push_back(values.size());
       }
     }
   }
+
+  // Bulk constructor: parses straight into the flat buffer, so the only
+  // allocations are the structural index and the amortized growth of values
+  // and offsets
+  explicit Table(std::string_view input, char delimiter = ' ') : offsets(1, 0) {
+    parseIndexedInto(input, delimiter, values, offsets);
+  }
   
   // Alternative constructor from parsed data
   Table(const std::vector<std::vector<T>>& tableData) {
+    size_t total = 0;
+    for (const auto& rowData : tableData) {
+      total += rowData.size();
+    }
+    values.reserve(total);
+    offsets.reserve(tableData.size() + 1);
+    offsets.push_back(0);
+    for (const auto& rowData : tableData) {
+      addRow(rowData.begin(), rowData.end());
+    }
+  }
+
+  // Flattens rows that are no longer needed, freeing each one as soon as it
+  // has been copied so the rows and the flat buffer are never both whole
+  Table(std::vector<std::vector<T>>&& tableData) {
+    size_t total = 0;
     for (const auto& rowData : tableData) {
-      data.emplace_back(rowData);
+      total += rowData.size();
+    }
+    values.reserve(total);
+    offsets.reserve(tableData.size() + 1);
+    offsets.push_back(0);
+    for (auto& rowData : tableData) {
+      addRow(rowData.begin(), rowData.end());
+      std::vector<T>().swap(rowData);
     }
+    tableData.clear();
   }
 
-  const Row<T>& operator[](int r) const
+  // Adopts an already flat buffer; offsets holds size() + 1 entries
+  // starting at 0, the same layout the table uses internally
+  Table(std::vector<T>&& values, std::vector<size_t>&& offsets)
+    : values(std::move(values)), offsets(std::move(offsets)) {}
+
+  // Appends a row holding the values in [first, last)
+  template <typename InputIt>
+  void addRow(InputIt first, InputIt last)
+  {
+    values.insert(values.end(), first, last);
+    offsets.push_back(values.size());
+  }
+
+  Row<T> operator[](int r) const
   {
-    return data[r]; 
+    return Row<T>(values.data() + offsets[r], offsets[r + 1] - offsets[r]);
   }
 
   size_t size() const
   {
-    return data.size();
+    return offsets.size() - 1;
   }
 
   ConstRowItr<T> begin() const
   {
-    return data.begin();
+    return ConstRowItr<T>(values.data(), offsets.data());
   }
 
   ConstRowItr<T> end() const
   {
-    return data.end();
+    return ConstRowItr<T>(values.data(), offsets.data() + size());
+  }
+
+  // The flat buffers themselves, e.g. to share the table across a C
+  // interface: size() + 1 offsets into the values
+  const T* valueData() const
+  {
+    return values.data();
+  }
+
+  const size_t* offsetData() const
+  {
+    return offsets.data();
   }
 
 private:
-  std::vector<Row<T>> data;
+  std::vector<T> values;
+  std::vector<size_t> offsets;
 };
 
+// Parses input on up to threads threads. The input is split into byte
+// ranges, each range is moved forward to start just after a newline, the
+// ranges are parsed concurrently into their own flat buffers and those are
+// stitched together in order. Inputs too small to be worth splitting are
+// parsed on the calling thread.
+template <typename T>
+Table<T> parseTableParallel(std::string_view input, unsigned threads, char delimiter = ' ') {
+    constexpr size_t kMinChunkSize = 1 << 20;
+    size_t chunks = std::min<size_t>(std::max(threads, 1u), std::max<size_t>(input.size() / kMinChunkSize, 1));
+    if (chunks == 1) {
+        return Table<T>(input, delimiter);
+    }
+
+    std::vector<size_t> bounds(chunks + 1, input.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < chunks; i++) {
+        size_t target = std::max(i * (input.size() / chunks), bounds[i - 1] + 1);
+        size_t newline = input.find('\n', target - 1);
+        bounds[i] = newline == std::string_view::npos ? input.size() : newline + 1;
+    }
+
+    struct Part {
+        std::vector<T> values;
+        std::vector<size_t> offsets;
+    };
+    std::vector<Part> parts(chunks);
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < chunks; i++) {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            std::string_view range = input.substr(bounds[i], bounds[i + 1] - bounds[i]);
+            parseIndexedInto(range, delimiter, parts[i].values, parts[i].offsets);
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // Stitch: each part is copied into its slot of the final buffers
+    std::vector<size_t> valueBase(chunks + 1, 0);
+    std::vector<size_t> rowBase(chunks + 1, 0);
+    for (size_t i = 0; i < chunks; i++) {
+        valueBase[i + 1] = valueBase[i] + parts[i].values.size();
+        rowBase[i + 1] = rowBase[i] + parts[i].offsets.size();
+    }
+    std::vector<T> values(valueBase[chunks]);
+    std::vector<size_t> offsets(rowBase[chunks] + 1, 0);
+    futures.clear();
+    for (size_t i = 0; i < chunks; i++) {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            std::move(parts[i].values.begin(), parts[i].values.end(), values.begin() + valueBase[i]);
+            for (size_t r = 0; r < parts[i].offsets.size(); r++) {
+                offsets[rowBase[i] + r + 1] = valueBase[i] + parts[i].offsets[r];
+            }
+            parts[i] = Part();
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    return Table<T>(std::move(values), std::move(offsets));
+}
+
 #endif
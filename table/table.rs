@@ -346,6 +346,159 @@ where
     Table::from_rows(rows)
 }
 
+/// The buffers behind a FlatTable produced on the Rust side
+struct FlatBuffers {
+    values: Vec<i32>,
+    row_offsets: Vec<usize>,
+}
+
+extern "C" fn release_flat_buffers(owner: *mut std::ffi::c_void) {
+    // SAFETY: owner came from Box::into_raw in FlatTable::from_flat
+    drop(unsafe { Box::from_raw(owner as *mut FlatBuffers) });
+}
+
+/// A table of i32 in one buffer, laid out as FlatTableI32 in flat_table.h so
+/// it can pass between Rust and C++ without copying. Row r is
+/// values[row_offsets[r]..row_offsets[r + 1]]. A FlatTable built here or
+/// received by value owns its buffers and releases them on drop, through
+/// whichever side allocated them.
+#[repr(C)]
+#[derive(Debug)]
+pub struct FlatTable {
+    values: *const i32,
+    row_offsets: *const usize,
+    row_count: usize,
+    owner: *mut std::ffi::c_void,
+    release: Option<extern "C" fn(*mut std::ffi::c_void)>,
+}
+
+impl FlatTable {
+    /// Takes ownership of already flat buffers; row_offsets must start at 0
+    /// and end at values.len()
+    pub fn from_flat(values: Vec<i32>, row_offsets: Vec<usize>) -> Self {
+        assert_eq!(row_offsets.first(), Some(&0), "row_offsets must start at 0");
+        assert_eq!(row_offsets.last(), Some(&values.len()), "row_offsets must end at values.len()");
+        let buffers = Box::new(FlatBuffers { values, row_offsets });
+        FlatTable {
+            values: buffers.values.as_ptr(),
+            row_offsets: buffers.row_offsets.as_ptr(),
+            row_count: buffers.row_offsets.len() - 1,
+            owner: Box::into_raw(buffers) as *mut std::ffi::c_void,
+            release: Some(release_flat_buffers),
+        }
+    }
+
+    /// Flattens a row-per-Vec table
+    pub fn from_table(table: &Table<i32>) -> Self {
+        let mut values = Vec::with_capacity(table.iter().map(|row| row.len()).sum());
+        let mut row_offsets = Vec::with_capacity(table.len() + 1);
+        row_offsets.push(0);
+        for row in table {
+            values.extend_from_slice(&row.data);
+            row_offsets.push(values.len());
+        }
+        FlatTable::from_flat(values, row_offsets)
+    }
+
+    /// An empty table that owns nothing
+    pub fn empty() -> Self {
+        static EMPTY_OFFSETS: [usize; 1] = [0];
+        FlatTable {
+            values: std::ptr::null(),
+            row_offsets: EMPTY_OFFSETS.as_ptr(),
+            row_count: 0,
+            owner: std::ptr::null_mut(),
+            release: None,
+        }
+    }
+
+    /// Parses one row per line that is not all whitespace straight into the
+    /// flat buffers. Follows flat_table.h: a ' ' delimiter splits on ASCII
+    /// whitespace; any other splits on itself, trimming each value and
+    /// skipping empty ones.
+    pub fn parse(input: &str, delimiter: char) -> Result<Self, std::num::ParseIntError> {
+        let mut values = Vec::new();
+        let mut row_offsets = vec![0];
+        for line in input.lines().filter(|line| !trim_ascii(line).is_empty()) {
+            if delimiter == ' ' {
+                for item in line.split_ascii_whitespace() {
+                    values.push(item.parse()?);
+                }
+            } else {
+                for item in line.split(delimiter).map(trim_ascii).filter(|item| !item.is_empty()) {
+                    values.push(item.parse()?);
+                }
+            }
+            row_offsets.push(values.len());
+        }
+        Ok(FlatTable::from_flat(values, row_offsets))
+    }
+
+    /// Gets the number of rows
+    pub fn row_count(&self) -> usize {
+        self.row_count
+    }
+
+    /// Checks if the table has no rows
+    pub fn is_empty(&self) -> bool {
+        self.row_count == 0
+    }
+
+    /// Every value, row after row
+    pub fn values(&self) -> &[i32] {
+        // SAFETY: the producer keeps row_offsets[row_count] values alive
+        // until release
+        unsafe { slice_or_empty(self.values, *self.row_offsets.add(self.row_count)) }
+    }
+
+    /// Gets row r as a slice of the shared buffer
+    pub fn row(&self, r: usize) -> &[i32] {
+        assert!(r < self.row_count, "row {} out of range", r);
+        // SAFETY: as for values(), and row_offsets holds row_count + 1 entries
+        unsafe {
+            let begin = *self.row_offsets.add(r);
+            let end = *self.row_offsets.add(r + 1);
+            slice_or_empty(self.values.add(begin), end - begin)
+        }
+    }
+
+    /// Returns an iterator over the rows
+    pub fn rows(&self) -> impl Iterator<Item = &[i32]> + '_ {
+        (0..self.row_count).map(move |r| self.row(r))
+    }
+
+    /// Copies the rows back out into a row-per-Vec table
+    pub fn to_table(&self) -> Table<i32> {
+        self.rows().map(|row| TableRow::from_vec(row.to_vec())).collect()
+    }
+}
+
+// The whitespace flat_table.h trims, which leaves out Unicode spaces
+fn trim_ascii(text: &str) -> &str {
+    text.trim_matches(|c: char| c.is_ascii_whitespace())
+}
+
+// Empty tables may come with a null values pointer, which a slice cannot hold
+unsafe fn slice_or_empty<'a>(data: *const i32, len: usize) -> &'a [i32] {
+    if len == 0 {
+        &[]
+    } else {
+        std::slice::from_raw_parts(data, len)
+    }
+}
+
+impl Drop for FlatTable {
+    fn drop(&mut self) {
+        if let Some(release) = self.release.take() {
+            release(self.owner);
+        }
+    }
+}
+
+// The buffers are never written through a FlatTable
+unsafe impl Send for FlatTable {}
+unsafe impl Sync for FlatTable {}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -696,4 +849,65 @@ mod tests {
         assert_eq!(table.len(), 0);
         assert!(table.is_empty());
     }
+
+    #[test]
+    fn test_flat_table_parse() {
+        let flat = FlatTable::parse("1 2 3\n\n4\n  5   6\n", ' ').unwrap();
+        assert_eq!(flat.row_count(), 3);
+        assert_eq!(flat.row(0), &[1, 2, 3]);
+        assert_eq!(flat.row(1), &[4]);
+        assert_eq!(flat.row(2), &[5, 6]);
+        assert_eq!(flat.values(), &[1, 2, 3, 4, 5, 6]);
+
+        let flat = FlatTable::parse("75,47,61\r\n97,13\r\n", ',').unwrap();
+        assert_eq!(flat.rows().collect::<Vec<_>>(), vec![&[75, 47, 61][..], &[97, 13][..]]);
+
+        assert!(FlatTable::parse("1 x 3\n", ' ').is_err());
+        assert!(FlatTable::parse("3 4x\n", ' ').is_err());
+
+        // Tabs split values and whitespace-only lines are not rows
+        let flat = FlatTable::parse(" \n1\t2\n\t\n", ' ').unwrap();
+        assert_eq!(flat.row_count(), 1);
+        assert_eq!(flat.row(0), &[1, 2]);
+    }
+
+    #[test]
+    fn test_flat_table_empty_owns_nothing() {
+        let empty = FlatTable::empty();
+        assert!(empty.is_empty());
+        assert!(empty.values().is_empty());
+        assert!(empty.release.is_none());
+    }
+
+    #[test]
+    fn test_flat_table_from_table() {
+        let table: Table<i32> = from_string_with("1 2\n3\n", |s| s.parse().unwrap());
+        let flat = FlatTable::from_table(&table);
+        assert_eq!(flat.row_count(), 2);
+        assert_eq!(flat.to_table(), table);
+
+        let empty = FlatTable::from_table(&Table::new());
+        assert!(empty.is_empty());
+        assert!(empty.values().is_empty());
+    }
+
+    #[test]
+    fn test_flat_table_drop_releases_once() {
+        static RELEASED: std::sync::atomic::AtomicUsize = std::sync::atomic::AtomicUsize::new(0);
+        extern "C" fn count_release(_: *mut std::ffi::c_void) {
+            RELEASED.fetch_add(1, std::sync::atomic::Ordering::SeqCst);
+        }
+        let offsets = [0usize, 2];
+        let values = [7, 8];
+        let borrowed = FlatTable {
+            values: values.as_ptr(),
+            row_offsets: offsets.as_ptr(),
+            row_count: 1,
+            owner: std::ptr::null_mut(),
+            release: Some(count_release),
+        };
+        assert_eq!(borrowed.row(0), &[7, 8]);
+        drop(borrowed);
+        assert_eq!(RELEASED.load(std::sync::atomic::Ordering::SeqCst), 1);
+    }
 }
@@ -0,0 +1,52 @@
+//! C entry points for FlatTable, declared in flat_table.h, so C++ code can
+//! hand its tables to Rust and take Rust-parsed tables back without copying.
+
+use std::os::raw::{c_char, c_int};
+
+use table_rust::FlatTable;
+
+/// Parses length bytes of text into *out, as flat_table.h describes. Returns
+/// 0 on success; on bad input or a null pointer returns nonzero and leaves
+/// *out an empty table with no release callback.
+///
+/// # Safety
+/// text must point to length readable bytes and out to writable memory for
+/// a FlatTableI32, whose previous contents are overwritten without release.
+#[no_mangle]
+pub unsafe extern "C" fn flat_table_i32_parse_rust(
+    text: *const c_char,
+    length: usize,
+    delimiter: c_char,
+    out: *mut FlatTable,
+) -> c_int {
+    if out.is_null() {
+        return 1;
+    }
+    // *out may be uninitialized, so it is written without dropping. On
+    // failure it stays this empty table, which has nothing to release.
+    std::ptr::write(out, FlatTable::empty());
+    if (text.is_null() && length > 0) || !(delimiter as u8).is_ascii() {
+        return 1;
+    }
+    let bytes = if length == 0 { &[][..] } else { std::slice::from_raw_parts(text as *const u8, length) };
+    let Ok(input) = std::str::from_utf8(bytes) else {
+        return 1;
+    };
+    match FlatTable::parse(input, delimiter as u8 as char) {
+        Ok(table) => {
+            *out = table;
+            0
+        }
+        Err(_) => 1,
+    }
+}
+
+/// Sum of every value in a table, whichever side produced it. The table is
+/// only borrowed.
+///
+/// # Safety
+/// table must point to a valid FlatTableI32.
+#[no_mangle]
+pub unsafe extern "C" fn flat_table_i32_sum_rust(table: *const FlatTable) -> i64 {
+    (*table).values().iter().map(|&value| i64::from(value)).sum()
+}
@@ -3,8 +3,15 @@
 #include <vector>
 #include <fstream>
 #include <numeric>
+#include <atomic>
+#include <type_traits>
 // #include "../flags/flags.h"
 #include "table.h"
+#include "columnar_table.h"
+#include "grid.h"
+#include "grid_scan.h"
+#include "sections.h"
+#include "allocation_counter.h"
 
 
 
@@ -239,3 +246,357 @@ TEST(Test, IntegrationParseAndConstruct) {
 }
 
 
+TEST(Test, RowsShareContiguousStorage) {
+    std::istringstream input("1 2\n3 4 5\n6");
+    Table<int> table(input);
+
+    // Rows are views into one buffer, laid out back to back
+    EXPECT_EQ(table[0].data() + table[0].size(), table[1].data());
+    EXPECT_EQ(table[1].data() + table[1].size(), table[2].data());
+    EXPECT_EQ(table.end() - table.begin(), 3);
+    EXPECT_EQ(table.begin()[1][2], 5);
+}
+
+TEST(Test, AddRow) {
+    Table<int> table;
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.begin(), table.end());
+
+    std::vector<int> first = {1, 2};
+    std::vector<int> second = {};
+    table.addRow(first.begin(), first.end());
+    table.addRow(second.begin(), second.end());
+
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_EQ(table[0][1], 2);
+    EXPECT_TRUE(table[1].empty());
+}
+TEST(Test, ParseTableFromStringView) {
+    // Same rows as the istream overload, including skipped empty lines
+    std::string_view input = "1 2\n\n3 4 5\n6";
+    auto result = parseTable<int>(input);
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0], (std::vector<int>{1, 2}));
+    EXPECT_EQ(result[1], (std::vector<int>{3, 4, 5}));
+    EXPECT_EQ(result[2], (std::vector<int>{6}));
+}
+
+TEST(Test, ParseValueMatchesStoiConventions) {
+    EXPECT_EQ(parseValue<int>("+7"), 7);
+    EXPECT_EQ(parseValue<int>(" 8"), 8);
+    EXPECT_EQ(parseValue<int>("9\r"), 9);
+    EXPECT_THROW(parseValue<int>("abc"), std::invalid_argument);
+    EXPECT_THROW(parseValue<int>("99999999999"), std::out_of_range);
+}
+
+TEST(Test, ParseRowIntoDoesNotAllocate) {
+    std::vector<int> ints;
+    ints.reserve(16);
+    std::vector<double> doubles;
+    doubles.reserve(16);
+
+    size_t before = allocationCount;
+    parseRowInto<int>("10  -20 30 +4", ' ', ints);
+    parseRowInto<double>("1.5,-2.25,3", ',', doubles);
+    EXPECT_EQ(allocationCount - before, 0);
+
+    EXPECT_EQ(ints, (std::vector<int>{10, -20, 30, 4}));
+    EXPECT_EQ(doubles, (std::vector<double>{1.5, -2.25, 3}));
+}
+
+TEST(Test, TableFromStringViewAllocatesPerBufferNotPerRow) {
+    std::string input;
+    for (int i = 0; i < 10000; i++) {
+        input += std::to_string(i) + "   " + std::to_string(-i) + "\n";
+    }
+
+    size_t before = allocationCount;
+    Table<int> table{std::string_view(input)};
+    size_t allocations = allocationCount - before;
+
+    ASSERT_EQ(table.size(), 10000);
+    EXPECT_EQ(table[9999][0], 9999);
+    EXPECT_EQ(table[9999][1], -9999);
+    // Only the geometric growth of the two flat buffers allocates
+    EXPECT_LT(allocations, 64);
+}
+
+TEST(Test, TableFromMovedRowsReleasesThem) {
+    std::vector<std::vector<int>> rows;
+    for (int i = 0; i < 1000; i++) {
+        rows.push_back({i, i + 1, i + 2});
+    }
+
+    size_t before = allocationCount;
+    Table<int> table(std::move(rows));
+    // Just the flat values and the offsets
+    EXPECT_EQ(allocationCount - before, 2);
+    EXPECT_TRUE(rows.empty());
+
+    ASSERT_EQ(table.size(), 1000);
+    EXPECT_EQ(table[999][2], 1001);
+}
+
+static size_t countCells(const Table<char>& table) {
+    size_t cells = 0;
+    for (const Row<char>& row : table) {
+        cells += row.size();
+    }
+    return cells;
+}
+
+TEST(Test, InputBytesAreMaterializedOnce) {
+    std::string input;
+    for (int i = 0; i < 2000; i++) {
+        input += std::string(99, 'A' + i % 26) + "\n";
+    }
+
+    // The cells are copied out of the input once, into the flat buffer; the
+    // offsets and scratch space come on top, but a second copy of the cells
+    // would double the total
+    size_t before = allocatedBytes;
+    Table<char> table{std::string_view(input)};
+    size_t parsed = allocatedBytes - before;
+    EXPECT_GE(parsed, 2000u * 99);
+    EXPECT_LT(parsed, input.size() * 3 / 2);
+
+    // Handing the table to a consumer by reference copies nothing
+    before = allocationCount;
+    EXPECT_EQ(countCells(table), 2000u * 99);
+    EXPECT_EQ(allocationCount - before, 0);
+}
+
+TEST(Test, StructuralIndexMatchesScalar) {
+    std::string input;
+    for (int i = 0; i < 1000; i++) {
+        input += std::to_string(i * 7919 % 1000) + (i % 13 == 0 ? "\n" : " ");
+    }
+
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < input.size(); i++) {
+        if (input[i] == '\n' || input[i] == ' ') {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<uint32_t> dispatched;
+    buildStructuralIndex(input.data(), input.size(), ' ', dispatched);
+    std::vector<uint32_t> scalar;
+    buildStructuralIndexScalar(input.data(), input.size(), ' ', scalar);
+
+    EXPECT_EQ(dispatched, expected);
+    EXPECT_EQ(scalar, expected);
+}
+
+TEST(Test, TableFromStringViewAcrossWindows) {
+    // Enough rows to span several index windows, plus one row longer than a
+    // window and CRLF line endings
+    std::string input;
+    for (int i = 0; i < 100000; i++) {
+        input += std::to_string(i) + " " + std::to_string(i % 7) + "\r\n";
+    }
+    input += "\n";
+    for (int i = 0; i < 100000; i++) {
+        input += "1 ";
+    }
+    input += "\n5";
+
+    Table<int> table{std::string_view(input)};
+    ASSERT_EQ(table.size(), 100002);
+    EXPECT_EQ(table[0][0], 0);
+    EXPECT_EQ(table[99999][0], 99999);
+    EXPECT_EQ(table[99999][1], 99999 % 7);
+    EXPECT_EQ(table[100000].size(), 100000);
+    EXPECT_EQ(table[100001][0], 5);
+    EXPECT_EQ(parseTable<int>(std::string_view(input)).size(), table.size());
+}
+
+TEST(Test, CharTableFromStringView) {
+    Table<char> table{std::string_view("AB\r\n\nC D\nXY")};
+
+    ASSERT_EQ(table.size(), 3);
+    EXPECT_EQ(std::string(table[0].begin(), table[0].end()), "AB");
+    EXPECT_EQ(std::string(table[1].begin(), table[1].end()), "C D");
+    EXPECT_EQ(std::string(table[2].begin(), table[2].end()), "XY");
+}
+
+TEST(Test, ParseTableParallelMatchesSequential) {
+    std::string input;
+    for (int i = 0; i < 400000; i++) {
+        input += std::to_string(i);
+        for (int j = 0; j < i % 5; j++) {
+            input += " " + std::to_string(j);
+        }
+        input += i % 1000 == 0 ? "\n\n" : "\n";
+    }
+    input += "1 2 3";
+
+    Table<int> sequential{std::string_view(input)};
+    for (unsigned threads : {1u, 3u, 8u}) {
+        Table<int> parallel = parseTableParallel<int>(input, threads);
+        ASSERT_EQ(parallel.size(), sequential.size());
+        for (size_t r = 0; r < sequential.size(); r++) {
+            ASSERT_TRUE(std::equal(parallel[r].begin(), parallel[r].end(),
+                                   sequential[r].begin(), sequential[r].end()));
+        }
+    }
+}
+
+TEST(Test, ParseTableParallelSmallInputs) {
+    EXPECT_EQ(parseTableParallel<int>("", 4).size(), 0);
+    Table<char> table = parseTableParallel<char>("AB\nCD", 4);
+    ASSERT_EQ(table.size(), 2);
+    EXPECT_EQ(table[1][1], 'D');
+}
+
+TEST(Test, ColumnarTableStoresColumnsContiguously) {
+    ColumnarTable<int> table{std::string_view("3   4\n4   3\n\n2   5\r\n")};
+
+    ASSERT_EQ(table.size(), 3);
+    ASSERT_EQ(table.columnCount(), 2);
+    EXPECT_EQ(std::vector<int>(table.column(0).begin(), table.column(0).end()), (std::vector<int>{3, 4, 2}));
+    EXPECT_EQ(std::vector<int>(table.column(1).begin(), table.column(1).end()), (std::vector<int>{4, 3, 5}));
+
+    std::vector<int> released = table.releaseColumn(1);
+    EXPECT_EQ(released, (std::vector<int>{4, 3, 5}));
+    EXPECT_EQ(table.column(1).size(), 0);
+}
+
+TEST(Test, ColumnarTableRejectsRaggedRows) {
+    EXPECT_THROW(ColumnarTable<int>(std::string_view("1 2\n3\n")), std::invalid_argument);
+    EXPECT_EQ(ColumnarTable<int>(std::string_view("")).columnCount(), 0);
+    EXPECT_THROW(ColumnarTable<int>(std::string_view("")).column(0), std::out_of_range);
+    EXPECT_THROW(ColumnarTable<int>(std::string_view("1 2\n")).releaseColumn(2), std::out_of_range);
+}
+
+TEST(Test, RowViewsOnlyLvalueVectors) {
+    static_assert(std::is_constructible<Row<int>, const std::vector<int>&>::value, "");
+    static_assert(!std::is_constructible<Row<int>, std::vector<int>&&>::value, "a Row must not view a temporary");
+}
+
+TEST(Test, GridPadsBordersWithSentinel) {
+    Table<char> table{std::string_view("ab\nc\n")};
+    Grid<char> grid(table, '#', 1, 3);
+    EXPECT_EQ(grid.height(), 2u);
+    EXPECT_EQ(grid.width(), 2u);
+    EXPECT_EQ(grid.stride(), 2u + 2 + 3);
+    EXPECT_EQ(grid(0, 0), 'a');
+    EXPECT_EQ(grid(0, 1), 'b');
+    EXPECT_EQ(grid(1, 0), 'c');
+    EXPECT_EQ(grid(1, 1), '#');  // short row filled out
+    for (ptrdiff_t c = -1; c < 2 + 1 + 3; c++) {
+        EXPECT_EQ(grid(-1, c), '#');
+        EXPECT_EQ(grid(2, c), '#');
+    }
+    EXPECT_EQ(grid(0, -1), '#');
+    EXPECT_EQ(grid(0, 2 + 3), '#');
+    EXPECT_EQ(std::string(grid.row(0).begin(), grid.row(0).end()), "ab");
+}
+
+TEST(Test, GridStencilOffsets) {
+    Grid<int> grid(3, 3, -1);
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            grid(r, c) = r * 3 + c;
+        }
+    }
+    const int* center = &grid(1, 1);
+    EXPECT_EQ((grid.neighbour<-1, -1>(center)), 0);
+    EXPECT_EQ((grid.neighbour<1, 0>(center)), 7);
+    EXPECT_EQ((grid.offset<0, 1>()), 1);
+    EXPECT_EQ((grid.offset<1, 0>()), static_cast<ptrdiff_t>(grid.stride()));
+
+    int sum = 0;
+    for (ptrdiff_t offset : grid.offsets(stencil::kNeighbours)) {
+        sum += center[offset];
+    }
+    EXPECT_EQ(sum, 36 - 4);
+
+    // Every neighbour of a corner outside the grid reads the sentinel
+    const int* corner = &grid(0, 0);
+    int outside = 0;
+    for (ptrdiff_t offset : grid.offsets(stencil::kNeighbours)) {
+        outside += corner[offset] == -1;
+    }
+    EXPECT_EQ(outside, 5);
+}
+
+TEST(Test, BandRowsFitCacheAndThreads) {
+    // 1000-byte rows, 64 KiB budget: half the budget holds 32 rows, less
+    // one halo row either side
+    EXPECT_EQ(bandRows(100000, 1000, 1, 1, 64 << 10), 30u);
+    // Few rows are still split across every thread
+    EXPECT_EQ(bandRows(40, 1000, 1, 4, 64 << 10), 10u);
+    EXPECT_EQ(bandRows(3, 1000, 1, 8, 64 << 10), 1u);
+    // Rows wider than the budget still make progress
+    EXPECT_EQ(bandRows(10, 1 << 20, 1, 1, 64 << 10), 1u);
+}
+
+TEST(Test, GridBandsMatchSerialScan) {
+    Grid<int> grid(257, 50, -1);
+    unsigned state = 1;
+    for (int r = 0; r < 257; r++) {
+        for (int c = 0; c < 50; c++) {
+            state = state * 1103515245 + 12345;
+            grid(r, c) = (state >> 16) % 3;
+        }
+    }
+    // Cells equal to the cell above, which reads across band edges
+    auto kernel = [](const Grid<int>& g, size_t rowBegin, size_t rowEnd) {
+        long long count = 0;
+        for (size_t r = rowBegin; r < rowEnd; r++) {
+            const int* cell = g.rowData(r);
+            for (size_t c = 0; c < g.width(); c++) {
+                count += cell[c] == (g.neighbour<-1, 0>(cell + c));
+            }
+        }
+        return count;
+    };
+    long long serial = kernel(grid, 0, grid.height());
+    ThreadPool pool(4);
+    EXPECT_EQ(scanGridBands(pool, grid, kernel, 4096), serial);
+    EXPECT_EQ(scanGridBands(pool, grid, kernel), serial);
+
+    std::atomic<size_t> rowsSeen{0};
+    scanRowBands(pool, 1000, 64, 0, [&](size_t rowBegin, size_t rowEnd) {
+        rowsSeen += rowEnd - rowBegin;
+        return 0;
+    }, 1024);
+    EXPECT_EQ(rowsSeen.load(), 1000u);
+}
+
+TEST(Test, SplitSectionsOnBlankLines) {
+    std::string_view input = "\n1|2\n3|4\n\n\r\n5,6\n\n7\n\n";
+    std::vector<std::string_view> sections = splitSections(input);
+    ASSERT_EQ(sections.size(), 3u);
+    EXPECT_EQ(sections[0], "1|2\n3|4\n");
+    EXPECT_EQ(sections[1], "5,6\n");
+    EXPECT_EQ(sections[2], "7\n");
+    // Views into the input, not copies
+    EXPECT_EQ(sections[0].data(), input.data() + 1);
+
+    EXPECT_TRUE(splitSections("").empty());
+    EXPECT_TRUE(splitSections("\n\r\n\n").empty());
+    EXPECT_EQ(splitSections("a\r\n\r\nb").size(), 2u);
+}
+
+TEST(Test, ParseSectionsWithOwnTypesAndDelimiters) {
+    auto [rules, updates, grid] =
+        parseSections("47|53\n97|13\n\n75,47,61\n97,61\n\nXM\nAS\n",
+                      Section<int>{'|'}, Section<int>{','}, Section<char>{});
+    ASSERT_EQ(rules.size(), 2);
+    EXPECT_EQ(rules[1][0], 97);
+    EXPECT_EQ(rules[1][1], 13);
+    ASSERT_EQ(updates.size(), 2);
+    EXPECT_EQ(updates[0].size(), 3u);
+    EXPECT_EQ(updates[0][2], 61);
+    ASSERT_EQ(grid.size(), 2);
+    EXPECT_EQ(grid[1][0], 'A');
+
+    // Missing sections are empty, extra ones are an error
+    auto [only, none] = parseSections("1|2\n", Section<int>{'|'}, Section<int>{','});
+    EXPECT_EQ(only.size(), 1);
+    EXPECT_EQ(none.size(), 0);
+    EXPECT_THROW(parseSections("1\n\n2\n", Section<int>{}), std::invalid_argument);
+}